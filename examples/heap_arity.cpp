@@ -0,0 +1,80 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+// Times a priority queue workload - pushes and pops interleaved over a
+// heap of n small keys - and heapsort with heaps of arity 2, 4 and 8.
+//
+//   heap_arity [n]
+//
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <experimental/ranges/algorithm>
+
+namespace ranges = std::experimental::ranges;
+
+namespace {
+	template<class F>
+	double milliseconds(F f) {
+		const auto start = std::chrono::steady_clock::now();
+		f();
+		const std::chrono::duration<double, std::milli> elapsed =
+			std::chrono::steady_clock::now() - start;
+		return elapsed.count();
+	}
+
+	template<std::size_t Arity>
+	void run(const std::vector<std::uint32_t>& keys) {
+		constexpr auto& push = ranges::ext::push_dary_heap<Arity>;
+		constexpr auto& pop = ranges::ext::pop_dary_heap<Arity>;
+
+		std::vector<std::uint32_t> heap(keys);
+		const double make = milliseconds([&] {
+			ranges::ext::make_dary_heap<Arity>(heap);
+		});
+
+		// Replace the top with a new key, as a top-k filter or an event
+		// queue does.
+		std::uint64_t checksum = 0;
+		const double queue = milliseconds([&] {
+			for (auto key : keys) {
+				pop(heap);
+				checksum += heap.back();
+				heap.back() = key;
+				push(heap);
+			}
+		});
+
+		const double sort = milliseconds([&] {
+			ranges::ext::sort_dary_heap<Arity>(heap);
+		});
+		if (!ranges::is_sorted(heap)) std::abort();
+
+		std::cout << "arity " << Arity << ": make " << make << " ms, pop+push "
+			<< queue << " ms, sort " << sort << " ms (" << checksum % 1000 << ")\n";
+	}
+}
+
+int main(int argc, char** argv) {
+	const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1u << 22;
+	std::mt19937 gen;
+	std::vector<std::uint32_t> keys(n);
+	for (auto& key : keys) key = gen();
+
+	std::cout << n << " keys\n";
+	run<2>(keys);
+	run<4>(keys);
+	run<8>(keys);
+}
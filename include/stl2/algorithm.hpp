@@ -25,6 +25,7 @@
 #include <stl2/detail/algorithm/copy_n.hpp>
 #include <stl2/detail/algorithm/count.hpp>
 #include <stl2/detail/algorithm/count_if.hpp>
+#include <stl2/detail/algorithm/dary_heap.hpp>
 #include <stl2/detail/algorithm/equal.hpp>
 #include <stl2/detail/algorithm/equal_range.hpp>
 #include <stl2/detail/algorithm/fill.hpp>
@@ -61,6 +62,7 @@
 #include <stl2/detail/algorithm/next_permutation.hpp>
 #include <stl2/detail/algorithm/none_of.hpp>
 #include <stl2/detail/algorithm/nth_element.hpp>
+#include <stl2/detail/algorithm/nth_elements.hpp>
 #include <stl2/detail/algorithm/partial_sort.hpp>
 #include <stl2/detail/algorithm/partial_sort_copy.hpp>
 #include <stl2/detail/algorithm/partition.hpp>
@@ -69,6 +71,7 @@
 #include <stl2/detail/algorithm/pop_heap.hpp>
 #include <stl2/detail/algorithm/prev_permutation.hpp>
 #include <stl2/detail/algorithm/push_heap.hpp>
+#include <stl2/detail/algorithm/radix_sort.hpp>
 #include <stl2/detail/algorithm/remove.hpp>
 #include <stl2/detail/algorithm/remove_copy.hpp>
 #include <stl2/detail/algorithm/remove_copy_if.hpp>
@@ -0,0 +1,152 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_BLOCK_PARTITION_HPP
+#define STL2_DETAIL_ALGORITHM_BLOCK_PARTITION_HPP
+
+#include <type_traits>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/memops.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/concepts/fundamental.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// detail::block_partition
+// (the branchless partitioning kernel shared by partition, sort and
+// nth_element)
+//
+// After BlockQuicksort (Edelkamp and Weiss, 2016): rather than branching
+// on each predicate result, a block of elements at each end of the range
+// is classified by storing the offset of every element unconditionally
+// and advancing the store position by the result. The misplaced elements
+// are then exchanged in bulk. The predicate is invoked once per element,
+// as by an ordinary partition, but no branch depends on its result.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		// Comparisons are cheap enough and hard enough to predict that
+		// partitioning should avoid branching on them.
+		template<class I, class Comp, class Proj>
+		META_CONCEPT BranchlessSortable =
+			ext::Arithmetic<iter_value_t<I>> &&
+			(IsFn<Comp, less> || IsFn<Comp, greater>) &&
+			IsFn<Proj, identity>;
+
+		// Exchanging elements is cheap enough that block_partition pays off
+		// for any predicate.
+		template<class I>
+		META_CONCEPT BlockPartitionable =
+			RandomAccessIterator<I> && Permutable<I> &&
+			std::is_trivially_copyable_v<iter_value_t<I>> &&
+			sizeof(iter_value_t<I>) <= 16;
+
+		// Elements classified per block.
+		inline constexpr std::ptrdiff_t partition_block_size = 64;
+
+		// Exchanges the elements at first + offsets_l[i] and
+		// last - offsets_r[i] for i in [0, n). Unless the two offset lists
+		// are the same length, a cyclic permutation with one temporary
+		// suffices in place of swaps.
+		template<RandomAccessIterator I>
+		requires Permutable<I>
+		void swap_offsets(I first, I last, const unsigned char* offsets_l,
+			const unsigned char* offsets_r, iter_difference_t<I> n, bool use_swaps)
+		{
+			if (use_swaps) {
+				for (iter_difference_t<I> i = 0; i < n; ++i) {
+					iter_swap(first + offsets_l[i], last - offsets_r[i]);
+				}
+			} else if (n > 0) {
+				I l = first + offsets_l[0];
+				I r = last - offsets_r[0];
+				iter_value_t<I> tmp = iter_move(l);
+				*l = iter_move(r);
+				for (iter_difference_t<I> i = 1; i < n; ++i) {
+					l = first + offsets_l[i];
+					*r = iter_move(l);
+					r = last - offsets_r[i];
+					*l = iter_move(r);
+				}
+				*r = std::move(tmp);
+			}
+		}
+
+		// Reorders [first, last) so that the elements satisfying pred
+		// precede those that do not; returns the partition point.
+		template<RandomAccessIterator I, class Pred>
+		requires Permutable<I>
+		I block_partition(I first, I last, Pred& pred) {
+			using D = iter_difference_t<I>;
+			constexpr D block_size = partition_block_size;
+
+			alignas(64) unsigned char offsets_l[block_size];
+			alignas(64) unsigned char offsets_r[block_size];
+			I base_l = first;
+			I base_r = last;
+			D num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+			while (first < last) {
+				// Fill whichever offset buffers are empty, splitting the
+				// unknown elements between them when both are.
+				const D unknown = last - first;
+				const D split_l = num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+				const D split_r = num_r == 0 ? unknown - split_l : 0;
+
+				const D count_l = split_l < block_size ? split_l : block_size;
+				for (D i = 0; i < count_l; ++i) {
+					offsets_l[num_l] = static_cast<unsigned char>(i);
+					num_l += !pred(*first);
+					++first;
+				}
+				const D count_r = split_r < block_size ? split_r : block_size;
+				for (D i = 0; i < count_r;) {
+					offsets_r[num_r] = static_cast<unsigned char>(++i);
+					num_r += static_cast<bool>(pred(*--last));
+				}
+
+				const D n = num_l < num_r ? num_l : num_r;
+				swap_offsets(base_l, base_r, offsets_l + start_l, offsets_r + start_r,
+					n, num_l == num_r);
+				num_l -= n;
+				num_r -= n;
+				start_l += n;
+				start_r += n;
+				if (num_l == 0) {
+					start_l = 0;
+					base_l = first;
+				}
+				if (num_r == 0) {
+					start_r = 0;
+					base_r = last;
+				}
+			}
+
+			// At most one side has misplaced elements left; move them to
+			// the boundary.
+			if (num_l) {
+				while (num_l--) {
+					iter_swap(base_l + offsets_l[start_l + num_l], --last);
+				}
+				first = last;
+			}
+			if (num_r) {
+				while (num_r--) {
+					iter_swap(base_r - offsets_r[start_r + num_r], first);
+					++first;
+				}
+			}
+			return first;
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -12,6 +12,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_COPY_HPP
 #define STL2_DETAIL_ALGORITHM_COPY_HPP
 
+#include <stl2/detail/algorithm/memops.hpp>
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/range/concepts.hpp>
 #include <stl2/detail/range/dangling.hpp>
@@ -28,6 +29,13 @@ STL2_OPEN_NAMESPACE {
 		requires IndirectlyCopyable<I, O>
 		constexpr copy_result<I, O>
 		operator()(I first, S last, O result) const {
+			if constexpr (SizedSentinel<S, I> && detail::MemCopyable<I, O>) {
+				if (!detail::is_constant_evaluated()) {
+					auto n = iter_difference_t<I>(last - first);
+					result = detail::memmove_n(first, n, std::move(result));
+					return {first + n, std::move(result)};
+				}
+			}
 			for (; first != last; (void) ++first, (void) ++result) {
 				*result = *first;
 			}
@@ -50,10 +58,8 @@ STL2_OPEN_NAMESPACE {
 			requires IndirectlyCopyable<I, O>
 			constexpr copy_result<I, O>
 			operator()(I first, S last, O result) const {
-				for (; first != last; (void) ++first, (void) ++result) {
-					*result = *first;
-				}
-				return {std::move(first), std::move(result)};
+				return __stl2::copy(std::move(first), std::move(last),
+					std::move(result));
 			}
 
 			template<InputRange R, class O>
@@ -70,6 +76,19 @@ STL2_OPEN_NAMESPACE {
 			requires IndirectlyCopyable<I1, I2>
 			constexpr copy_result<I1, I2>
 			operator()(I1 first, S1 last, I2 rfirst, S2 rlast) const {
+				if constexpr (SizedSentinel<S1, I1> && SizedSentinel<S2, I2> &&
+					detail::MemCopyable<I1, I2>)
+				{
+					if (!detail::is_constant_evaluated()) {
+						auto n = iter_difference_t<I1>(last - first);
+						auto rn = iter_difference_t<I2>(rlast - rfirst);
+						if (static_cast<iter_difference_t<I1>>(rn) < n) {
+							n = static_cast<iter_difference_t<I1>>(rn);
+						}
+						rfirst = detail::memmove_n(first, n, std::move(rfirst));
+						return {first + n, std::move(rfirst)};
+					}
+				}
 				for (; first != last && rfirst != rlast; (void) ++first, (void)++rfirst) {
 					*rfirst = *first;
 				}
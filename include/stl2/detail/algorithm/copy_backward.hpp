@@ -13,6 +13,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_COPY_BACKWARD_HPP
 #define STL2_DETAIL_ALGORITHM_COPY_BACKWARD_HPP
 
+#include <stl2/detail/algorithm/memops.hpp>
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/range/concepts.hpp>
 #include <stl2/detail/range/dangling.hpp>
@@ -30,6 +31,12 @@ STL2_OPEN_NAMESPACE {
 		constexpr copy_backward_result<I1, I2>
 		operator()(I1 first, S1 sent, I2 out) const {
 			auto last = next(first, std::move(sent));
+			if constexpr (detail::MemCopyable<I1, I2>) {
+				if (!detail::is_constant_evaluated()) {
+					out = detail::memmove_backward_n(last, last - first, std::move(out));
+					return {std::move(last), std::move(out)};
+				}
+			}
 			auto i = last;
 			while (i != first) {
 				*--out = *--i;
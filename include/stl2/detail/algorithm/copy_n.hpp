@@ -13,6 +13,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_COPY_N_HPP
 #define STL2_DETAIL_ALGORITHM_COPY_N_HPP
 
+#include <stl2/detail/algorithm/memops.hpp>
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/iterator/concepts.hpp>
 #include <stl2/detail/iterator/counted_iterator.hpp>
@@ -32,6 +33,15 @@ STL2_OPEN_NAMESPACE {
 			if (n < 0) n = 0;
 			auto norig = n;
 			auto first = ext::uncounted(first_);
+			if constexpr (detail::MemCopyable<decltype(first), O>) {
+				if (!detail::is_constant_evaluated()) {
+					result = detail::memmove_n(first, n, std::move(result));
+					return {
+						ext::recounted(first_, first + n, norig),
+						std::move(result)
+					};
+				}
+			}
 			for(; n > 0; (void) ++first, (void) ++result, --n) {
 				*result = *first;
 			}
@@ -12,6 +12,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_COUNT_HPP
 #define STL2_DETAIL_ALGORITHM_COUNT_HPP
 
+#include <stl2/detail/algorithm/memops.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/concepts.hpp>
 
@@ -24,6 +25,14 @@ STL2_OPEN_NAMESPACE {
 		requires IndirectRelation<equal_to, projected<I, Proj>, const T*>
 		constexpr iter_difference_t<I>
 		operator()(I first, S last, const T& value, Proj proj = {}) const {
+			if constexpr (SizedSentinel<S, I> && detail::IsFn<Proj, identity> &&
+				detail::MemFindable<I, T>)
+			{
+				if (!detail::is_constant_evaluated()) {
+					return detail::memcount_n(std::move(first),
+						iter_difference_t<I>(last - first), value);
+				}
+			}
 			iter_difference_t<I> n = 0;
 			for (; first != last; ++first) {
 				if (__stl2::invoke(proj, *first) == value) {
@@ -12,8 +12,11 @@
 #ifndef STL2_DETAIL_ALGORITHM_COUNT_IF_HPP
 #define STL2_DETAIL_ALGORITHM_COUNT_IF_HPP
 
+#include <atomic>
 #include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/execution.hpp>
 #include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/range/primitives.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // count_if [alg.count]
@@ -39,6 +42,40 @@ STL2_OPEN_NAMESPACE {
 		operator()(R&& r, Pred pred, Proj proj = {}) const {
 			return (*this)(begin(r), end(r), __stl2::ref(pred), __stl2::ref(proj));
 		}
+
+		/// Extension: parallel count_if
+		///
+		template<RandomAccessIterator I, SizedSentinel<I> S, class Proj = identity,
+			IndirectUnaryPredicate<projected<I, Proj>> Pred>
+		iter_difference_t<I>
+		operator()(const ext::parallel_policy& policy, I first, S last, Pred pred,
+			Proj proj = {}) const
+		{
+			using D = iter_difference_t<I>;
+			std::atomic<D> total{0};
+			detail::parallel_for(policy, D(last - first), [&](D b, D e) {
+				auto n = D{0};
+				for (auto i = first + b, end = first + e; i != end; ++i) {
+					if (__stl2::invoke(pred, __stl2::invoke(proj, *i))) {
+						++n;
+					}
+				}
+				total.fetch_add(n, std::memory_order_relaxed);
+			});
+			return total.load();
+		}
+
+		template<RandomAccessRange R, class Proj = identity,
+			IndirectUnaryPredicate<projected<iterator_t<R>, Proj>> Pred>
+		requires SizedRange<R>
+		iter_difference_t<iterator_t<R>>
+		operator()(const ext::parallel_policy& policy, R&& r, Pred pred,
+			Proj proj = {}) const
+		{
+			auto first = begin(r);
+			return (*this)(policy, first, first + distance(r), __stl2::ref(pred),
+				__stl2::ref(proj));
+		}
 	};
 
 	inline constexpr __count_if_fn count_if {};
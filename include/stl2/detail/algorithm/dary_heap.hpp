@@ -0,0 +1,213 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_DARY_HEAP_HPP
+#define STL2_DETAIL_ALGORITHM_DARY_HEAP_HPP
+
+#include <cstddef>
+#include <stl2/detail/algorithm/heap_sift.hpp>
+#include <stl2/detail/algorithm/is_heap_until.hpp>
+#include <stl2/detail/algorithm/pop_heap.hpp>
+#include <stl2/detail/range/dangling.hpp>
+#include <stl2/detail/range/primitives.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// make_dary_heap, push_dary_heap, pop_dary_heap, sort_dary_heap,
+// is_dary_heap_until and is_dary_heap [Extension]
+//
+// The heap algorithms for heaps in which each element has Arity children,
+// at Arity * i + 1 through Arity * i + Arity. A wider heap is shallower:
+// popping visits log_Arity(n) levels rather than log_2(n), comparing
+// Arity - 1 adjacent children at each, so for small elements it touches
+// fewer cache lines at the price of more comparisons. Arity 2 is the
+// standard heap layout.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		template<std::size_t Arity>
+		struct __make_dary_heap_fn : private __niebloid {
+			template<RandomAccessIterator I, Sentinel<I> S, class Comp = less,
+				class Proj = identity>
+			requires Sortable<I, Comp, Proj>
+			constexpr I
+			operator()(I first, S last, Comp comp = {}, Proj proj = {}) const {
+				auto n = distance(first, std::move(last));
+				make_heap_n(first, n, comp, proj);
+				return first + n;
+			}
+
+			template<RandomAccessRange Rng, class Comp = less, class Proj = identity>
+			requires Sortable<iterator_t<Rng>, Comp, Proj>
+			constexpr safe_iterator_t<Rng>
+			operator()(Rng&& rng, Comp comp = {}, Proj proj = {}) const {
+				auto n = distance(rng);
+				make_heap_n(begin(rng), n, comp, proj);
+				return begin(rng) + n;
+			}
+		private:
+			template<RandomAccessIterator I, class Comp, class Proj>
+			requires Sortable<I, Comp, Proj>
+			static constexpr void make_heap_n(I first, iter_difference_t<I> n,
+				Comp& comp, Proj& proj)
+			{
+				constexpr auto d = static_cast<iter_difference_t<I>>(Arity);
+				if (n > 1) {
+					// start from the last parent, there is no need to consider children
+					for (auto start = (n - 2) / d; start >= 0; --start) {
+						detail::dary_sift_down_n<Arity>(first, n, first + start,
+							__stl2::ref(comp), __stl2::ref(proj));
+					}
+				}
+			}
+		};
+
+		template<std::size_t Arity>
+		inline constexpr __make_dary_heap_fn<Arity> make_dary_heap {};
+
+		template<std::size_t Arity>
+		struct __push_dary_heap_fn : private __niebloid {
+			template<RandomAccessIterator I, Sentinel<I> S, class Comp = less,
+				class Proj = identity>
+			requires Sortable<I, Comp, Proj>
+			constexpr I
+			operator()(I first, S last, Comp comp = {}, Proj proj = {}) const {
+				auto n = distance(first, std::move(last));
+				detail::dary_sift_up_n<Arity>(first, n, __stl2::ref(comp),
+					__stl2::ref(proj));
+				return first + n;
+			}
+
+			template<RandomAccessRange R, class Comp = less, class Proj = identity>
+			requires Sortable<iterator_t<R>, Comp, Proj>
+			constexpr safe_iterator_t<R>
+			operator()(R&& r, Comp comp = {}, Proj proj = {}) const {
+				auto n = distance(r);
+				detail::dary_sift_up_n<Arity>(begin(r), n, __stl2::ref(comp),
+					__stl2::ref(proj));
+				return begin(r) + n;
+			}
+		};
+
+		template<std::size_t Arity>
+		inline constexpr __push_dary_heap_fn<Arity> push_dary_heap {};
+
+		template<std::size_t Arity>
+		struct __pop_dary_heap_fn : private __niebloid {
+			template<RandomAccessIterator I, Sentinel<I> S, class Comp = less,
+				class Proj = identity>
+			requires Sortable<I, Comp, Proj>
+			constexpr I
+			operator()(I first, S last, Comp comp = {}, Proj proj = {}) const {
+				auto n = distance(first, std::move(last));
+				detail::dary_pop_heap_n<Arity>(first, n, __stl2::ref(comp),
+					__stl2::ref(proj));
+				return first + n;
+			}
+
+			template<RandomAccessRange R, class Comp = less, class Proj = identity>
+			requires Sortable<iterator_t<R>, Comp, Proj>
+			constexpr safe_iterator_t<R>
+			operator()(R&& r, Comp comp = {}, Proj proj = {}) const {
+				auto n = distance(r);
+				detail::dary_pop_heap_n<Arity>(begin(r), n, __stl2::ref(comp),
+					__stl2::ref(proj));
+				return begin(r) + n;
+			}
+		};
+
+		template<std::size_t Arity>
+		inline constexpr __pop_dary_heap_fn<Arity> pop_dary_heap {};
+
+		template<std::size_t Arity>
+		struct __sort_dary_heap_fn : private __niebloid {
+			template<RandomAccessIterator I, Sentinel<I> S, class Comp = less,
+				class Proj = identity>
+			requires Sortable<I, Comp, Proj>
+			constexpr I
+			operator()(I first, S last, Comp comp = {}, Proj proj = {}) const {
+				auto n = distance(first, std::move(last));
+				sort_heap_n(first, n, comp, proj);
+				return first + n;
+			}
+
+			template<RandomAccessRange R, class Comp = less, class Proj = identity>
+			requires Sortable<iterator_t<R>, Comp, Proj>
+			constexpr safe_iterator_t<R>
+			operator()(R&& r, Comp comp = {}, Proj proj = {}) const {
+				auto n = distance(r);
+				sort_heap_n(begin(r), n, comp, proj);
+				return begin(r) + n;
+			}
+		private:
+			template<RandomAccessIterator I, class Comp, class Proj>
+			requires Sortable<I, Comp, Proj>
+			static constexpr void sort_heap_n(I first, iter_difference_t<I> n,
+				Comp& comp, Proj& proj)
+			{
+				for (; n > 1; --n) {
+					detail::dary_pop_heap_n<Arity>(first, n, __stl2::ref(comp),
+						__stl2::ref(proj));
+				}
+			}
+		};
+
+		template<std::size_t Arity>
+		inline constexpr __sort_dary_heap_fn<Arity> sort_dary_heap {};
+
+		template<std::size_t Arity>
+		struct __is_dary_heap_until_fn : private __niebloid {
+			template<RandomAccessIterator I, Sentinel<I> S, class Proj = identity,
+				IndirectStrictWeakOrder<projected<I, Proj>> Comp = less>
+			constexpr I
+			operator()(I first, S last, Comp comp = {}, Proj proj = {}) const {
+				auto n = distance(first, std::move(last));
+				return detail::is_dary_heap_until_n<Arity>(std::move(first), n,
+					__stl2::ref(comp), __stl2::ref(proj));
+			}
+
+			template<RandomAccessRange Rng, class Proj = identity,
+				IndirectStrictWeakOrder<projected<iterator_t<Rng>, Proj>> Comp = less>
+			constexpr safe_iterator_t<Rng>
+			operator()(Rng&& rng, Comp comp = {}, Proj proj = {}) const {
+				return detail::is_dary_heap_until_n<Arity>(begin(rng), distance(rng),
+					__stl2::ref(comp), __stl2::ref(proj));
+			}
+		};
+
+		template<std::size_t Arity>
+		inline constexpr __is_dary_heap_until_fn<Arity> is_dary_heap_until {};
+
+		template<std::size_t Arity>
+		struct __is_dary_heap_fn : private __niebloid {
+			template<RandomAccessIterator I, Sentinel<I> S, class Proj = identity,
+				IndirectStrictWeakOrder<projected<I, Proj>> Comp = less>
+			constexpr bool
+			operator()(I first, S last, Comp comp = {}, Proj proj = {}) const {
+				auto n = distance(first, last);
+				return first + n == detail::is_dary_heap_until_n<Arity>(first, n,
+					__stl2::ref(comp), __stl2::ref(proj));
+			}
+
+			template<RandomAccessRange Rng, class Proj = identity,
+				IndirectStrictWeakOrder<projected<iterator_t<Rng>, Proj>> Comp = less>
+			constexpr bool
+			operator()(Rng&& rng, Comp comp = {}, Proj proj = {}) const {
+				return end(rng) == detail::is_dary_heap_until_n<Arity>(begin(rng),
+					distance(rng), __stl2::ref(comp), __stl2::ref(proj));
+			}
+		};
+
+		template<std::size_t Arity>
+		inline constexpr __is_dary_heap_fn<Arity> is_dary_heap {};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -12,6 +12,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_EQUAL_HPP
 #define STL2_DETAIL_ALGORITHM_EQUAL_HPP
 
+#include <stl2/detail/algorithm/memops.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/primitives.hpp>
 
@@ -27,6 +28,14 @@ STL2_OPEN_NAMESPACE {
 		static constexpr bool __equal_3(I1 first1, S1 last1, I2 first2,
 			Pred& pred, Proj1& proj1, Proj2& proj2)
 		{
+			if constexpr (SizedSentinel<S1, I1> && detail::MemComparable<I1, I2> &&
+				detail::IsFn<Pred, equal_to> && detail::IsFn<Proj1, identity> &&
+				detail::IsFn<Proj2, identity>)
+			{
+				if (!detail::is_constant_evaluated()) {
+					return detail::memequal_n(first1, first2, last1 - first1);
+				}
+			}
 			for (; first1 != last1; (void) ++first1, (void) ++first2) {
 				if (!__stl2::invoke(pred,
 						__stl2::invoke(proj1, *first1),
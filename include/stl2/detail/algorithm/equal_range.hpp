@@ -13,6 +13,7 @@
 #define STL2_DETAIL_ALGORITHM_EQUAL_RANGE_HPP
 
 #include <stl2/detail/algorithm/lower_bound.hpp>
+#include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/algorithm/upper_bound.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/view/subrange.hpp>
@@ -28,6 +29,16 @@ STL2_OPEN_NAMESPACE {
 			constexpr subrange<I>
 			operator()(I first, iter_difference_t<I> dist, const T& value,
 				Comp comp = {}, Proj proj = {}) const {
+				if constexpr (detail::BranchlessSearchable<I, T, Comp, Proj>) {
+					// Two branchless searches beat one that branches.
+					if (!detail::is_constant_evaluated()) {
+						auto lo = ext::lower_bound_n(first, dist, value,
+							__stl2::ref(comp), __stl2::ref(proj));
+						auto hi = ext::upper_bound_n(lo, dist - (lo - first), value,
+							__stl2::ref(comp), __stl2::ref(proj));
+						return {std::move(lo), std::move(hi)};
+					}
+				}
 				if (0 < dist) {
 					do {
 						auto half = dist / 2;
@@ -125,6 +136,57 @@ STL2_OPEN_NAMESPACE {
 	};
 
 	inline constexpr __equal_range_fn equal_range {};
+
+	namespace ext {
+		template<class I, class O>
+		using equal_range_batch_result = __in_out_result<I, O>;
+
+		// Writes to result, for each needle in turn, the subrange
+		// equal_range would return for it. As with lower_bound_batch,
+		// each search starts from the answer to the previous one, and the
+		// upper bound is sought from the lower.
+		struct __equal_range_batch_fn : private __niebloid {
+			template<RandomAccessIterator I, SizedSentinel<I> S, InputIterator I2,
+				Sentinel<I2> S2, WeaklyIncrementable O, class Comp = less,
+				class Proj = identity>
+			requires IndirectStrictWeakOrder<Comp, I2, projected<I, Proj>> &&
+				Writable<O, subrange<I>>
+			constexpr equal_range_batch_result<I2, O>
+			operator()(I first, S last, I2 needles, S2 needles_last, O result,
+				Comp comp = {}, Proj proj = {}) const
+			{
+				const auto n = iter_difference_t<I>(last - first);
+				iter_difference_t<I> hint = 0;
+				for (; needles != needles_last; (void) ++needles, (void) ++result) {
+					iter_reference_t<I2>&& value = *needles;
+					const auto lo = detail::finger_partition_point(first, n, hint,
+						[&](auto&& e) -> bool {
+							return __stl2::invoke(comp, __stl2::invoke(proj, e), value);
+						});
+					hint = detail::finger_partition_point(first, n, lo,
+						[&](auto&& e) -> bool {
+							return !__stl2::invoke(comp, value, __stl2::invoke(proj, e));
+						});
+					*result = subrange<I>{first + lo, first + hint};
+				}
+				return {std::move(needles), std::move(result)};
+			}
+
+			template<RandomAccessRange R, InputRange R2, WeaklyIncrementable O,
+				class Comp = less, class Proj = identity>
+			requires SizedRange<R> && _ForwardingRange<R> &&
+				IndirectStrictWeakOrder<Comp, iterator_t<R2>, projected<iterator_t<R>, Proj>> &&
+				Writable<O, subrange<iterator_t<R>>>
+			constexpr equal_range_batch_result<safe_iterator_t<R2>, O>
+			operator()(R&& r, R2&& needles, O result, Comp comp = {}, Proj proj = {}) const {
+				auto first = begin(r);
+				return (*this)(first, first + distance(r), begin(needles), end(needles),
+					std::move(result), __stl2::ref(comp), __stl2::ref(proj));
+			}
+		};
+
+		inline constexpr __equal_range_batch_fn equal_range_batch {};
+	}
 } STL2_CLOSE_NAMESPACE
 
 #endif
@@ -12,6 +12,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_FILL_HPP
 #define STL2_DETAIL_ALGORITHM_FILL_HPP
 
+#include <stl2/detail/algorithm/memops.hpp>
 #include <stl2/detail/range/concepts.hpp>
 #include <stl2/detail/range/dangling.hpp>
 
@@ -21,6 +22,12 @@ STL2_OPEN_NAMESPACE {
 	struct __fill_fn : private __niebloid {
 		template<class T, OutputIterator<const T&> O, Sentinel<O> S>
 		constexpr O operator()(O first, S last, const T& value) const {
+			if constexpr (SizedSentinel<S, O> && detail::MemFillable<O, T>) {
+				if (!detail::is_constant_evaluated()) {
+					return detail::memfill_n(std::move(first),
+						iter_difference_t<O>(last - first), value);
+				}
+			}
 			for (; first != last; ++first) {
 				*first = value;
 			}
@@ -12,6 +12,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_FILL_N_HPP
 #define STL2_DETAIL_ALGORITHM_FILL_N_HPP
 
+#include <stl2/detail/algorithm/memops.hpp>
 #include <stl2/detail/iterator/concepts.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -22,6 +23,12 @@ STL2_OPEN_NAMESPACE {
 		template<class T, OutputIterator<const T&> O>
 		constexpr O
 		operator()(O first, iter_difference_t<O> n, const T& value) const {
+			if constexpr (detail::MemFillable<O, T>) {
+				if (!detail::is_constant_evaluated()) {
+					return detail::memfill_n(std::move(first),
+						n < 0 ? 0 : n, value);
+				}
+			}
 			for (; n > 0; --n, (void)++first) {
 				*first = value;
 			}
@@ -12,6 +12,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_FIND_HPP
 #define STL2_DETAIL_ALGORITHM_FIND_HPP
 
+#include <stl2/detail/algorithm/memops.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/dangling.hpp>
 
@@ -24,6 +25,14 @@ STL2_OPEN_NAMESPACE {
 		requires IndirectRelation<equal_to, projected<I, Proj>, const T*>
 		constexpr I
 		operator()(I first, S last, const T& value, Proj proj = {}) const {
+			if constexpr (SizedSentinel<S, I> && detail::IsFn<Proj, identity> &&
+				detail::MemFindable<I, T>)
+			{
+				if (!detail::is_constant_evaluated()) {
+					return detail::memfind_n(std::move(first),
+						iter_difference_t<I>(last - first), value);
+				}
+			}
 			for (; first != last; ++first) {
 				if (__stl2::invoke(proj, *first) == value) {
 					break;
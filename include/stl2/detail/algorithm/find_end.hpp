@@ -15,6 +15,7 @@
 
 #include <optional>
 
+#include <stl2/detail/algorithm/searchers.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/primitives.hpp>
 
@@ -120,6 +121,32 @@ STL2_OPEN_NAMESPACE {
 			return (*this)(begin(r1), end(r1), begin(r2), end(r2),
 				__stl2::ref(pred), __stl2::ref(proj1), __stl2::ref(proj2));
 		}
+
+		/// Extension: find_end using a pattern-preprocessing Searcher
+		/// Restarts the searcher just past each match, so the work is
+		/// that of one forward search plus the cost of each match found.
+		///
+		template<ForwardIterator I, Sentinel<I> S, ext::Searcher<I> Searcher>
+		I operator()(I first, S last, const Searcher& searcher) const {
+			auto end = next(first, std::move(last));
+			auto result = end;
+			while (true) {
+				auto match = searcher(first, end);
+				if (match.begin() == match.end()) {
+					return result;
+				}
+				result = match.begin();
+				first = next(result);
+			}
+		}
+
+		/// Extension: find_end over a range using a pattern-preprocessing
+		/// Searcher
+		///
+		template<ForwardRange R, ext::Searcher<iterator_t<R>> Searcher>
+		safe_iterator_t<R> operator()(R&& r, const Searcher& searcher) const {
+			return (*this)(begin(r), end(r), searcher);
+		}
 	};
 
 	inline constexpr __find_end_fn find_end {};
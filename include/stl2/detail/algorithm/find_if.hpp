@@ -13,7 +13,9 @@
 #define STL2_DETAIL_ALGORITHM_FIND_IF_HPP
 
 #include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/execution.hpp>
 #include <stl2/detail/range/dangling.hpp>
+#include <stl2/detail/range/primitives.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // find_if [alg.find]
@@ -39,6 +41,31 @@ STL2_OPEN_NAMESPACE {
 			return (*this)(begin(r), end(r), __stl2::ref(pred),
 				__stl2::ref(proj));
 		}
+
+		/// Extension: parallel find_if
+		///
+		template<RandomAccessIterator I, SizedSentinel<I> S, class Proj = identity,
+			IndirectUnaryPredicate<projected<I, Proj>> Pred>
+		I operator()(const ext::parallel_policy& policy, I first, S last, Pred pred,
+			Proj proj = {}) const
+		{
+			return first + detail::parallel_find(policy,
+				iter_difference_t<I>(last - first), [&](auto i) -> bool {
+					return __stl2::invoke(pred, __stl2::invoke(proj, first[i]));
+				});
+		}
+
+		template<RandomAccessRange R, class Proj = identity,
+			IndirectUnaryPredicate<projected<iterator_t<R>, Proj>> Pred>
+		requires SizedRange<R>
+		safe_iterator_t<R>
+		operator()(const ext::parallel_policy& policy, R&& r, Pred pred,
+			Proj proj = {}) const
+		{
+			auto first = begin(r);
+			return (*this)(policy, first, first + distance(r), __stl2::ref(pred),
+				__stl2::ref(proj));
+		}
 	};
 
 	inline constexpr __find_if_fn find_if {};
@@ -14,7 +14,9 @@
 
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/execution.hpp>
 #include <stl2/detail/range/dangling.hpp>
+#include <stl2/detail/range/primitives.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // for_each [alg.foreach]
@@ -40,6 +42,35 @@ STL2_OPEN_NAMESPACE {
 		operator()(R&& r, F fun, Proj proj = {}) const {
 			return (*this)(begin(r), end(r), std::move(fun), std::move(proj));
 		}
+
+		/// Extension: parallel for_each
+		///
+		template<RandomAccessIterator I, SizedSentinel<I> S, class Proj = identity,
+			IndirectUnaryInvocable<projected<I, Proj>> F>
+		for_each_result<I, F>
+		operator()(const ext::parallel_policy& policy, I first, S last, F fun,
+			Proj proj = {}) const
+		{
+			const auto n = iter_difference_t<I>(last - first);
+			detail::parallel_for(policy, n, [&](auto b, auto e) {
+				for (auto i = first + b, end = first + e; i != end; ++i) {
+					__stl2::invoke(fun, __stl2::invoke(proj, *i));
+				}
+			});
+			return {first + n, std::move(fun)};
+		}
+
+		template<RandomAccessRange R, class Proj = identity,
+			IndirectUnaryInvocable<projected<iterator_t<R>, Proj>> F>
+		requires SizedRange<R>
+		for_each_result<safe_iterator_t<R>, F>
+		operator()(const ext::parallel_policy& policy, R&& r, F fun,
+			Proj proj = {}) const
+		{
+			auto first = begin(r);
+			return (*this)(policy, first, first + distance(r), std::move(fun),
+				std::move(proj));
+		}
 	};
 
 	inline constexpr __for_each_fn for_each {};
@@ -22,20 +22,39 @@
 #ifndef STL2_DETAIL_ALGORITHM_HEAP_SIFT_HPP
 #define STL2_DETAIL_ALGORITHM_HEAP_SIFT_HPP
 
+#include <cstddef>
 #include <stl2/detail/concepts/callable.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
-// detail::sift_up_n and detail::sift_down_n
+// detail::sift_up_n, detail::sift_down_n, detail::bottom_up_sift_down_n
+// and their d-ary forms detail::dary_sift_up_n, detail::dary_sift_down_n
+// and detail::dary_bottom_up_sift_down_n
 // (heap implementation details)
 //
+// sift_down_n compares the element with the greatest child at each level
+// it descends, which costs Arity comparisons a level. After a pop, or when
+// partial_sort replaces the top, the element at the top comes from the
+// bottom of the heap and usually belongs there again: bottom_up_sift_down_n
+// (Floyd; Wegener, "Bottom-up heapsort", 1993) instead moves the greatest
+// children up into the hole it leaves until the hole reaches a leaf, for
+// Arity - 1 comparisons a level, then sifts the element up from that leaf,
+// which is seldom more than a level or two.
+//
 STL2_OPEN_NAMESPACE {
 	namespace detail {
+		// The children of element i of a heap of arity Arity are elements
+		// Arity * i + 1 through Arity * i + Arity; its parent is element
+		// (i - 1) / Arity. The standard heap algorithms use Arity == 2.
+		template<std::size_t Arity>
 		struct __sift_up_n_fn {
+			static_assert(Arity >= 2);
+
 			template<RandomAccessIterator I, class Comp, class Proj>
 			requires Sortable<I, Comp, Proj>
 			constexpr void operator()(I first, iter_difference_t<I> n,
 				Comp comp, Proj proj) const
 			{
+				constexpr auto d = static_cast<iter_difference_t<I>>(Arity);
 				if (n <= 1) return;
 
 				auto pred = [&](auto&& lhs, auto&& rhs) -> bool {
@@ -45,7 +64,7 @@ STL2_OPEN_NAMESPACE {
 				};
 
 				I last = first + n;
-				n = (n - 2) / 2;
+				n = (n - 2) / d;
 				I i = first + n;
 				if (!pred(*i, *--last)) return;
 
@@ -54,7 +73,7 @@ STL2_OPEN_NAMESPACE {
 					*last = iter_move(i);
 					last = i;
 					if (n == 0) break;
-					n = (n - 1) / 2;
+					n = (n - 1) / d;
 					i = first + n;
 				} while(pred(*i, v));
 
@@ -62,34 +81,43 @@ STL2_OPEN_NAMESPACE {
 			}
 		};
 
-		inline constexpr __sift_up_n_fn sift_up_n {};
+		template<std::size_t Arity>
+		inline constexpr __sift_up_n_fn<Arity> dary_sift_up_n {};
+		inline constexpr __sift_up_n_fn<2> sift_up_n {};
 
+		template<std::size_t Arity>
 		struct __sift_down_n_fn {
+			static_assert(Arity >= 2);
+
 			template<RandomAccessIterator I, class Comp, class Proj>
 			requires Sortable<I, Comp, Proj>
 			constexpr void operator()(I first, iter_difference_t<I> n, I start,
 				Comp comp, Proj proj) const
 			{
-				// left-child of start is at 2 * start + 1
-				// right-child of start is at 2 * start + 2
+				constexpr auto d = static_cast<iter_difference_t<I>>(Arity);
+				// the first child of start is at d * start + 1
 				auto child = start - first;
 
-				if (n < 2 || (n - 2) / 2 < child) return;
+				if (n < 2 || (n - 2) / d < child) return;
 
 				auto pred = [&](auto&& lhs, auto&& rhs) -> bool {
 					return __stl2::invoke(comp,
 						__stl2::invoke(proj, static_cast<decltype(lhs)>(lhs)),
 						__stl2::invoke(proj, static_cast<decltype(rhs)>(rhs)));
 				};
+				// Returns the greatest of the children starting at child,
+				// and updates child to its index. The choice is a select
+				// rather than a branch, as the comparisons are unpredictable.
+				auto greatest_child = [&] {
+					const auto last_child = n - child < d ? n : child + d;
+					for (auto c = child + 1; c < last_child; ++c) {
+						child = pred(*(first + child), *(first + c)) ? c : child;
+					}
+					return first + child;
+				};
 
-				child = 2 * child + 1;
-				I child_i = first + child;
-
-				if ((child + 1) < n && pred(*child_i, *(child_i + 1))) {
-					// right-child exists and is greater than left-child
-					++child_i;
-					++child;
-				}
+				child = d * child + 1;
+				I child_i = greatest_child();
 
 				// check if we are in heap-order
 				if (pred(*child_i, *start)) {
@@ -103,17 +131,11 @@ STL2_OPEN_NAMESPACE {
 					*start = iter_move(child_i);
 					start = child_i;
 
-					if ((n - 2) / 2 < child) break;
+					if ((n - 2) / d < child) break;
 
 					// recompute the child based off of the updated parent
-					child = 2 * child + 1;
-					child_i = first + child;
-
-					if ((child + 1) < n && pred(*child_i, *(child_i + 1))) {
-						// right-child exists and is greater than left-child
-						++child_i;
-						++child;
-					}
+					child = d * child + 1;
+					child_i = greatest_child();
 
 					// check if we are in heap-order
 				} while (!pred(*child_i, top));
@@ -122,7 +144,52 @@ STL2_OPEN_NAMESPACE {
 			}
 		};
 
-		inline constexpr __sift_down_n_fn sift_down_n {};
+		template<std::size_t Arity>
+		inline constexpr __sift_down_n_fn<Arity> dary_sift_down_n {};
+		inline constexpr __sift_down_n_fn<2> sift_down_n {};
+
+		template<std::size_t Arity>
+		struct __bottom_up_sift_down_n_fn {
+			static_assert(Arity >= 2);
+
+			// Restores heap order to [first, first + n) when only *first may
+			// be out of place.
+			template<RandomAccessIterator I, class Comp, class Proj>
+			requires Sortable<I, Comp, Proj>
+			constexpr void operator()(I first, iter_difference_t<I> n,
+				Comp comp, Proj proj) const
+			{
+				constexpr auto d = static_cast<iter_difference_t<I>>(Arity);
+				if (n < 2) return;
+
+				auto pred = [&](auto&& lhs, auto&& rhs) -> bool {
+					return __stl2::invoke(comp,
+						__stl2::invoke(proj, static_cast<decltype(lhs)>(lhs)),
+						__stl2::invoke(proj, static_cast<decltype(rhs)>(rhs)));
+				};
+
+				iter_value_t<I> top = iter_move(first);
+				// descend to a leaf, promoting the greatest child at each level
+				iter_difference_t<I> hole = 0;
+				do {
+					auto child = d * hole + 1;
+					const auto last_child = n - child < d ? n : child + d;
+					for (auto c = child + 1; c < last_child; ++c) {
+						child = pred(*(first + child), *(first + c)) ? c : child;
+					}
+					*(first + hole) = iter_move(first + child);
+					hole = child;
+				} while (hole <= (n - 2) / d);
+
+				*(first + hole) = std::move(top);
+				dary_sift_up_n<Arity>(first, hole + 1, __stl2::ref(comp),
+					__stl2::ref(proj));
+			}
+		};
+
+		template<std::size_t Arity>
+		inline constexpr __bottom_up_sift_down_n_fn<Arity> dary_bottom_up_sift_down_n {};
+		inline constexpr __bottom_up_sift_down_n_fn<2> bottom_up_sift_down_n {};
 	}
 } STL2_CLOSE_NAMESPACE
 
@@ -12,12 +12,17 @@
 #ifndef STL2_DETAIL_ALGORITHM_INCLUDES_HPP
 #define STL2_DETAIL_ALGORITHM_INCLUDES_HPP
 
+#include <stl2/detail/algorithm/memops.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/concepts.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // includes [includes]
 //
+// For contiguous ranges of integers sorted by <, the elements of the second
+// are found in the first by galloping when it is much longer, and several
+// elements at a time otherwise.
+//
 STL2_OPEN_NAMESPACE {
 	struct __includes_fn : private  __niebloid {
 		template<InputIterator I1, Sentinel<I1> S1, InputIterator I2,
@@ -27,6 +32,14 @@ STL2_OPEN_NAMESPACE {
 		constexpr bool operator()(I1 first1, S1 last1, I2 first2, S2 last2,
 			Comp comp = {}, Proj1 proj1 = {}, Proj2 proj2 = {}) const
 		{
+			if constexpr (SizedSentinel<S1, I1> && SizedSentinel<S2, I2> &&
+				detail::MemSetOperable<I1, I2, Comp, Proj1, Proj2>)
+			{
+				if (!detail::is_constant_evaluated()) {
+					return detail::memincludes_n(first1, last1 - first1,
+						first2, last2 - first2);
+				}
+			}
 			while (true) {
 				if (first2 == last2) return true;
 				if (first1 == last1) return false;
@@ -22,6 +22,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_IS_HEAP_UNTIL_HPP
 #define STL2_DETAIL_ALGORITHM_IS_HEAP_UNTIL_HPP
 
+#include <cstddef>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/primitives.hpp>
 
@@ -30,38 +31,36 @@
 //
 STL2_OPEN_NAMESPACE {
 	namespace detail {
+		template<std::size_t Arity>
 		struct __is_heap_until_n_fn {
+			static_assert(Arity >= 2);
+
 			template<RandomAccessIterator I, class Proj = identity,
 				IndirectStrictWeakOrder<projected<I, Proj>> Comp = less>
 			constexpr I operator()(I first, const iter_difference_t<I> n,
 				Comp comp = {}, Proj proj = {}) const
 			{
+				constexpr auto d = static_cast<iter_difference_t<I>>(Arity);
 				STL2_EXPECT(0 <= n);
-				iter_difference_t<I> p = 0, c = 1;
-				I pp = first;
-				while (c < n) {
-					I cp = first + c;
-					if (__stl2::invoke(comp,
-							__stl2::invoke(proj, *pp),
-							__stl2::invoke(proj, *cp))) {
-						return cp;
-					}
-					++c;
-					++cp;
-					if (c == n || __stl2::invoke(comp,
-							__stl2::invoke(proj, *pp),
-							__stl2::invoke(proj, *cp))) {
-						return cp;
+				// The children of *pp are the d elements from c on.
+				iter_difference_t<I> c = 1;
+				for (I pp = first; c < n; ++pp) {
+					for (iter_difference_t<I> k = 0; k < d && c < n; ++k, ++c) {
+						I cp = first + c;
+						if (__stl2::invoke(comp,
+								__stl2::invoke(proj, *pp),
+								__stl2::invoke(proj, *cp))) {
+							return cp;
+						}
 					}
-					++p;
-					++pp;
-					c = 2 * p + 1;
 				}
 				return first + n;
 			}
 		};
 
-		inline constexpr __is_heap_until_n_fn is_heap_until_n {};
+		template<std::size_t Arity>
+		inline constexpr __is_heap_until_n_fn<Arity> is_dary_heap_until_n {};
+		inline constexpr __is_heap_until_n_fn<2> is_heap_until_n {};
 	}
 
 	struct __is_heap_until_fn : private __niebloid {
@@ -14,10 +14,14 @@
 #define STL2_DETAIL_ALGORITHM_IS_PERMUTATION_HPP
 
 #include <limits>
+#include <new>
+#include <unordered_map>
 
 #include <stl2/detail/algorithm/count_if.hpp>
 #include <stl2/detail/algorithm/find_if.hpp>
+#include <stl2/detail/algorithm/memops.hpp>
 #include <stl2/detail/algorithm/mismatch.hpp>
+#include <stl2/detail/hash.hpp>
 #include <stl2/detail/iterator/counted_iterator.hpp>
 #include <stl2/detail/iterator/unreachable.hpp>
 #include <stl2/detail/range/primitives.hpp>
@@ -26,6 +30,18 @@
 // is_permutation [alg.is_permutation]
 //
 STL2_OPEN_NAMESPACE {
+	namespace detail {
+		// The projected elements of both ranges have the same Hashable
+		// value type, compared with ==, so that they can be counted in a
+		// hash table keyed by copies of the values.
+		template<class I1, class I2, class Pred, class Proj1, class Proj2>
+		META_CONCEPT HashCountable =
+			IsFn<Pred, equal_to> &&
+			Same<iter_value_t<projected<I1, Proj1>>, iter_value_t<projected<I2, Proj2>>> &&
+			ext::Hashable<iter_value_t<projected<I1, Proj1>>> &&
+			CopyConstructible<iter_value_t<projected<I1, Proj1>>>;
+	}
+
 	struct __is_permutation_fn : private __niebloid {
 		template<ForwardIterator I1, Sentinel<I1> S1, ForwardIterator I2,
 			Sentinel<I2> S2, class Pred = equal_to, class Proj1 = identity,
@@ -180,6 +196,17 @@ STL2_OPEN_NAMESPACE {
 			STL2_ASSERT(!__stl2::invoke(pred, __stl2::invoke(proj1, *first1), __stl2::invoke(proj2, *first2)));
 			if (n == 1) return false;
 
+			if constexpr (detail::HashCountable<I1, I2, Pred, Proj1, Proj2>) {
+				if (n >= hash_threshold) {
+					try {
+						return __is_permutation_hash(first1, first2, n, proj1, proj2);
+					} catch (std::bad_alloc&) {
+						// Fall back to the quadratic algorithm, which does
+						// not allocate.
+					}
+				}
+			}
+
 			// For each element in [first1, n), see if there are the same number of
 			// equal elements in [first2, n)
 			counted_iterator<I1> i{first1, n};
@@ -212,6 +239,31 @@ STL2_OPEN_NAMESPACE {
 			return true;
 		}
 
+		// Tails shorter than this are compared pairwise: the quadratic
+		// algorithm beats building a hash table for them.
+		static constexpr int hash_threshold = 64;
+
+		// Counts the values of [first1, n) in a hash table, then checks
+		// off those of [first2, n) against the counts, in expected O(n)
+		// time.
+		template<ForwardIterator I1, ForwardIterator I2, class Proj1, class Proj2>
+		static bool __is_permutation_hash(I1 first1, I2 first2,
+			iter_difference_t<I1> n, Proj1& proj1, Proj2& proj2)
+		{
+			using V = iter_value_t<projected<I1, Proj1>>;
+			using D = iter_difference_t<I1>;
+			std::unordered_map<V, D, __hash::__fn, equal_to> counts;
+			counts.reserve(static_cast<std::size_t>(n));
+			for (D i = 0; i < n; ++i, ++first1) {
+				++counts[__stl2::invoke(proj1, *first1)];
+			}
+			for (D i = 0; i < n; ++i, ++first2) {
+				auto pos = counts.find(__stl2::invoke(proj2, *first2));
+				if (pos == counts.end() || pos->second-- == 0) return false;
+			}
+			return true;
+		}
+
 		template<ForwardIterator I1, ForwardIterator I2,
 			class Pred, class Proj1, class Proj2>
 		requires IndirectlyComparable<I1, I2, Pred, Proj1, Proj2>
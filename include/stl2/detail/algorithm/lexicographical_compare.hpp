@@ -12,6 +12,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_LEXICOGRAPHICAL_COMPARE_HPP
 #define STL2_DETAIL_ALGORITHM_LEXICOGRAPHICAL_COMPARE_HPP
 
+#include <stl2/detail/algorithm/memops.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/concepts.hpp>
 
@@ -27,6 +28,22 @@ STL2_OPEN_NAMESPACE {
 		constexpr bool operator()(I1 first1, S1 last1, I2 first2, S2 last2,
 			Comp comp = {}, Proj1 proj1 = {}, Proj2 proj2 = {}) const
 		{
+			if constexpr (SizedSentinel<S1, I1> && SizedSentinel<S2, I2> &&
+				detail::MemComparable<I1, I2> &&
+				(detail::IsFn<Comp, less> || detail::IsFn<Comp, greater>) &&
+				detail::IsFn<Proj1, identity> && detail::IsFn<Proj2, identity>)
+			{
+				if (!detail::is_constant_evaluated()) {
+					// Only the first pair of elements that differ matters.
+					const auto n1 = last1 - first1;
+					const auto n2 = static_cast<iter_difference_t<I1>>(last2 - first2);
+					const auto n = n1 < n2 ? n1 : n2;
+					const auto k = detail::memmismatch_n(first1, first2, n);
+					if (k == n) return n1 < n2;
+					return __stl2::invoke(comp, first1[k],
+						first2[static_cast<iter_difference_t<I2>>(k)]);
+				}
+			}
 			while (true) {
 				const bool at_end2 = first2 == last2;
 
@@ -12,9 +12,12 @@
 #ifndef STL2_DETAIL_ALGORITHM_LOWER_BOUND_HPP
 #define STL2_DETAIL_ALGORITHM_LOWER_BOUND_HPP
 
+#include <memory>
 #include <stl2/detail/algorithm/partition_point.hpp>
+#include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/primitives.hpp>
+#include <stl2/detail/simd/config.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // lower_bound [lower.bound]
@@ -31,6 +34,12 @@ STL2_OPEN_NAMESPACE {
 				auto pred = [&](auto&& i) -> bool {
 					return __stl2::invoke(comp, i, value);
 				};
+				if constexpr (detail::BranchlessSearchable<__f<I>, T, Comp, Proj>) {
+					if (!detail::is_constant_evaluated()) {
+						return detail::branchless_partition_point_n(
+							std::forward<I>(first), n, std::move(pred));
+					}
+				}
 				return __stl2::ext::partition_point_n(std::forward<I>(first), n,
 					std::move(pred), __stl2::ref(proj));
 			}
@@ -75,6 +84,174 @@ STL2_OPEN_NAMESPACE {
 	};
 
 	inline constexpr __lower_bound_fn lower_bound {};
+
+	namespace detail {
+		struct __finger_partition_point_fn {
+			// Returns the partition point of [first, first + n) with
+			// respect to pred, which holds for a prefix of it, given a
+			// hint that is likely to be close to it. The search first
+			// probes outward from the hint at distances doubling up to
+			// 2^gallop_steps, and only then falls back to binary search
+			// of what remains, so a good hint costs O(log d) probes for
+			// an answer d away and a bad one costs a few more probes
+			// than no hint at all.
+			template<RandomAccessIterator I, class Pred>
+			constexpr iter_difference_t<I> operator()(I first, iter_difference_t<I> n,
+				iter_difference_t<I> hint, Pred pred) const
+			{
+				using D = iter_difference_t<I>;
+				STL2_EXPECT(0 <= hint && hint <= n);
+				D lo, hi; // The answer is in [lo, hi].
+				if (hint < n && pred(first[hint])) {
+					lo = hint + 1;
+					hi = n;
+					D step = 1;
+					for (int i = 0; i < gallop_steps && lo < hi; ++i, step *= 2) {
+						const D probe = (hi - lo < step ? hi : lo + step) - 1;
+						if (!pred(first[probe])) {
+							hi = probe;
+							break;
+						}
+						lo = probe + 1;
+					}
+				} else {
+					if (hint == 0 || pred(first[hint - 1])) return hint;
+					lo = 0;
+					hi = hint - 1;
+					D step = 1;
+					for (int i = 0; i < gallop_steps && lo < hi; ++i, step *= 2) {
+						const D probe = hi - lo < step ? lo : hi - step;
+						if (pred(first[probe])) {
+							lo = probe + 1;
+							break;
+						}
+						hi = probe;
+					}
+				}
+				return lo + (ext::partition_point_n(first + lo, hi - lo, std::move(pred)) - (first + lo));
+			}
+		private:
+			static constexpr int gallop_steps = 6;
+		};
+
+		inline constexpr __finger_partition_point_fn finger_partition_point {};
+	}
+
+	namespace ext {
+		template<class I, class O>
+		using lower_bound_batch_result = __in_out_result<I, O>;
+
+		// Writes to result, for each needle in turn, the iterator
+		// lower_bound would return for it. Each search starts from the
+		// answer to the previous one, so sorted needles are matched in a
+		// single merge-like sweep. Needles that are arithmetic values
+		// searched for in arithmetic values with less or greater are taken
+		// in blocks; a block that is out of order is searched branchlessly
+		// as a group, one step of every search at a time, so that the
+		// cache misses of the independent searches overlap.
+		struct __lower_bound_batch_fn : private __niebloid {
+			template<RandomAccessIterator I, SizedSentinel<I> S, InputIterator I2,
+				Sentinel<I2> S2, WeaklyIncrementable O, class Comp = less,
+				class Proj = identity>
+			requires IndirectStrictWeakOrder<Comp, I2, projected<I, Proj>> &&
+				Writable<O, const I&>
+			constexpr lower_bound_batch_result<I2, O>
+			operator()(I first, S last, I2 needles, S2 needles_last, O result,
+				Comp comp = {}, Proj proj = {}) const
+			{
+				const auto n = iter_difference_t<I>(last - first);
+				if constexpr (detail::BranchlessSearchable<I, iter_value_t<I2>, Comp, Proj>) {
+					if (!detail::is_constant_evaluated()) {
+						return interleaved(first, n, std::move(needles),
+							std::move(needles_last), std::move(result), comp);
+					}
+				}
+				iter_difference_t<I> hint = 0;
+				for (; needles != needles_last; (void) ++needles, (void) ++result) {
+					iter_reference_t<I2>&& value = *needles;
+					hint = detail::finger_partition_point(first, n, hint,
+						[&](auto&& e) -> bool {
+							return __stl2::invoke(comp, __stl2::invoke(proj, e), value);
+						});
+					*result = first + hint;
+				}
+				return {std::move(needles), std::move(result)};
+			}
+
+			template<RandomAccessRange R, InputRange R2, WeaklyIncrementable O,
+				class Comp = less, class Proj = identity>
+			requires SizedRange<R> && _ForwardingRange<R> &&
+				IndirectStrictWeakOrder<Comp, iterator_t<R2>, projected<iterator_t<R>, Proj>> &&
+				Writable<O, const iterator_t<R>&>
+			constexpr lower_bound_batch_result<safe_iterator_t<R2>, O>
+			operator()(R&& r, R2&& needles, O result, Comp comp = {}, Proj proj = {}) const {
+				auto first = begin(r);
+				return (*this)(first, first + distance(r), begin(needles), end(needles),
+					std::move(result), __stl2::ref(comp), __stl2::ref(proj));
+			}
+		private:
+			static constexpr int lanes = 8;
+
+			template<class I, class I2, class S2, class O, class Comp>
+			static lower_bound_batch_result<I2, O>
+			interleaved(I first, iter_difference_t<I> n, I2 needles, S2 needles_last,
+				O result, Comp& comp)
+			{
+				using D = iter_difference_t<I>;
+				iter_value_t<I2> keys[lanes];
+				D base[lanes];
+				D hint = 0;
+				while (needles != needles_last) {
+					int m = 0;
+					bool sorted = true;
+					do {
+						keys[m] = *needles;
+						++needles;
+						if (m > 0 && __stl2::invoke(comp, keys[m], keys[m - 1])) {
+							sorted = false;
+						}
+						++m;
+					} while (m < lanes && needles != needles_last);
+
+					if (sorted || m < lanes) {
+						for (int j = 0; j < m; ++j) {
+							const auto& key = keys[j];
+							hint = base[j] = detail::finger_partition_point(first, n, hint,
+								[&](const auto& e) -> bool {
+									return __stl2::invoke(comp, e, key);
+								});
+						}
+					} else {
+						for (int j = 0; j < lanes; ++j) base[j] = 0;
+						for (D len = n; len > 1;) {
+							const D half = len / 2;
+							len -= half;
+							for (int j = 0; j < lanes; ++j) {
+								base[j] += __stl2::invoke(comp, first[base[j] + half], keys[j]) ? half : 0;
+								if constexpr (ContiguousIterator<I>) {
+									// This search's next probe, fetched while the
+									// other lanes take their steps.
+									detail::simd::prefetch(std::addressof(*first) + (base[j] + len / 2));
+								}
+							}
+						}
+						if (n > 0) {
+							for (int j = 0; j < lanes; ++j) {
+								base[j] += __stl2::invoke(comp, first[base[j]], keys[j]) ? 1 : 0;
+							}
+						}
+						hint = base[lanes - 1];
+					}
+					for (int j = 0; j < m; ++j, ++result) {
+						*result = first + base[j];
+					}
+				}
+				return {std::move(needles), std::move(result)};
+			}
+		};
+
+		inline constexpr __lower_bound_batch_fn lower_bound_batch {};
+	}
 } STL2_CLOSE_NAMESPACE
 
 #endif
@@ -12,6 +12,8 @@
 #ifndef STL2_DETAIL_ALGORITHM_MAX_ELEMENT_HPP
 #define STL2_DETAIL_ALGORITHM_MAX_ELEMENT_HPP
 
+#include <memory>
+#include <stl2/detail/algorithm/memops.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/dangling.hpp>
 
@@ -24,11 +26,23 @@ STL2_OPEN_NAMESPACE {
 			IndirectStrictWeakOrder<projected<I, Proj>> Comp = less>
 		constexpr I
 		operator()(I first, S last, Comp comp = {}, Proj proj = {}) const {
+			if constexpr (SizedSentinel<S, I> && detail::MemOrderable<I, Comp, Proj>) {
+				if (!detail::is_constant_evaluated() && first != last) {
+					// The first element whose value is greatest under comp.
+					const auto p = std::addressof(*first);
+					const auto n = last - first;
+					detail::simd::extrema<iter_value_t<I>> e{};
+					if (detail::simd::find_extrema(p, p + n, e)) {
+						const auto& greatest = detail::IsFn<Comp, less> ? e.max : e.min;
+						return first + (detail::simd::find_value(p, p + n, greatest) - p);
+					}
+				}
+			}
 			if (first != last) {
 				for (auto i = next(first); i != last; ++i) {
-					if (!__stl2::invoke(comp,
-							__stl2::invoke(proj, *i),
-							__stl2::invoke(proj, *first))) {
+					if (__stl2::invoke(comp,
+							__stl2::invoke(proj, *first),
+							__stl2::invoke(proj, *i))) {
 						first = i;
 					}
 				}
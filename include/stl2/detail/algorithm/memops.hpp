@@ -0,0 +1,400 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_MEMOPS_HPP
+#define STL2_DETAIL_ALGORITHM_MEMOPS_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <stl2/functional.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/results.hpp>
+#include <stl2/detail/concepts/fundamental.hpp>
+#include <stl2/detail/concepts/object.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+#include <stl2/detail/simd/filter.hpp>
+#include <stl2/detail/simd/find.hpp>
+#include <stl2/detail/simd/intersect.hpp>
+#include <stl2/detail/simd/minmax.hpp>
+#include <stl2/detail/simd/mismatch.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// detail::memmove_n, detail::memmove_backward_n, detail::memfill_n,
+// detail::memfind_n, detail::memcount_n, detail::memequal_n,
+// detail::memmismatch_n, detail::memfilter_n, detail::memfilter_copy_n,
+// detail::memintersect_n and detail::memincludes_n
+// (fast paths for algorithms over contiguous ranges of trivial types)
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		template<class F>
+		struct __unwrap_fn { using type = F; };
+		template<class F>
+		struct __unwrap_fn<reference_wrapper<F>> { using type = std::remove_const_t<F>; };
+		template<class F>
+		struct __unwrap_fn<std::reference_wrapper<F>> { using type = std::remove_const_t<F>; };
+
+		// F is the function object type G, or a reference_wrapper thereof.
+		// Used to recognize default projections and predicates, which the
+		// algorithms forward as __stl2::ref(proj).
+		template<class F, class G>
+		META_CONCEPT IsFn = Same<meta::_t<__unwrap_fn<__uncvref<F>>>, G>;
+
+		// A ContiguousIterator that denotes non-volatile storage, whose
+		// elements may therefore be accessed as raw bytes.
+		template<class I>
+		META_CONCEPT MemIterator =
+			ContiguousIterator<I> &&
+			!std::is_volatile_v<std::remove_reference_t<iter_reference_t<I>>>;
+
+		// Copying the elements of [i, i + n) to [o, o + n) is equivalent to
+		// copying their object representations.
+		template<class I, class O>
+		META_CONCEPT MemCopyable =
+			MemIterator<I> && MemIterator<O> &&
+			Same<iter_value_t<I>, iter_value_t<O>> &&
+			ext::TriviallyCopyable<iter_value_t<I>> &&
+			IndirectlyCopyable<I, O>;
+
+		// Moving the elements of [i, i + n) to [o, o + n) is equivalent to
+		// copying their object representations.
+		template<class I, class O>
+		META_CONCEPT MemMovable =
+			MemCopyable<I, O> &&
+			Same<iter_rvalue_reference_t<I>, iter_value_t<I>&&>;
+
+		struct __memmove_n_fn {
+			// Copies the n elements starting at first to the n elements
+			// starting at result; the ranges may overlap. Returns result + n.
+			template<class I, class O>
+			requires MemCopyable<I, O>
+			O operator()(I first, iter_difference_t<I> n, O result) const noexcept {
+				STL2_EXPECT(n >= 0);
+				if (n > 0) {
+					std::memmove(std::addressof(*result), std::addressof(*first),
+						static_cast<std::size_t>(n) * sizeof(iter_value_t<I>));
+					result += static_cast<iter_difference_t<O>>(n);
+				}
+				return result;
+			}
+		};
+
+		inline constexpr __memmove_n_fn memmove_n {};
+
+		struct __memmove_backward_n_fn {
+			// Copies the n elements ending at last to the n elements ending
+			// at result; the ranges may overlap. Returns result - n.
+			template<class I, class O>
+			requires MemCopyable<I, O>
+			O operator()(I last, iter_difference_t<I> n, O result) const noexcept {
+				STL2_EXPECT(n >= 0);
+				if (n > 0) {
+					last -= n;
+					result -= static_cast<iter_difference_t<O>>(n);
+					std::memmove(std::addressof(*result), std::addressof(*last),
+						static_cast<std::size_t>(n) * sizeof(iter_value_t<I>));
+				}
+				return result;
+			}
+		};
+
+		inline constexpr __memmove_backward_n_fn memmove_backward_n {};
+
+		// Assigning a const T& to each element of [o, o + n) is equivalent to
+		// copying the object representation of a single converted value.
+		template<class O, class T>
+		META_CONCEPT MemFillable =
+			MemIterator<O> &&
+			ext::TriviallyCopyable<iter_value_t<O>> &&
+			OutputIterator<O, const T&> &&
+			(Same<T, iter_value_t<O>> ||
+				(std::is_scalar_v<T> && std::is_scalar_v<iter_value_t<O>>));
+
+		struct __memfill_n_fn {
+			// Assigns value to the n elements starting at first. Returns
+			// first + n.
+			template<class O, class T>
+			requires MemFillable<O, T>
+			O operator()(O first, iter_difference_t<O> n, const T& value) const noexcept {
+				using V = iter_value_t<O>;
+				STL2_EXPECT(n >= 0);
+				if (n <= 0) return first;
+
+				const V v = value;
+				V* p = std::addressof(*first);
+				first += n;
+				if constexpr (sizeof(V) == 1) {
+					unsigned char byte;
+					std::memcpy(&byte, std::addressof(v), 1);
+					std::memset(p, byte, static_cast<std::size_t>(n));
+				} else {
+					// Broadcast v into a block of block_bytes and store whole
+					// blocks; fixed-size memcpys lower to wide vector stores.
+					constexpr std::size_t block_bytes = 64;
+					constexpr iter_difference_t<O> block = block_bytes / sizeof(V);
+					if constexpr (block >= 2) {
+						if (n >= block) {
+							alignas(V) unsigned char pattern[block * sizeof(V)];
+							for (iter_difference_t<O> i = 0; i < block; ++i) {
+								std::memcpy(pattern + i * sizeof(V), std::addressof(v), sizeof(V));
+							}
+							do {
+								std::memcpy(p, pattern, sizeof(pattern));
+								p += block;
+								n -= block;
+							} while (n >= block);
+						}
+					}
+					for (; n > 0; --n, ++p) {
+						*p = v;
+					}
+				}
+				return first;
+			}
+		};
+
+		inline constexpr __memfill_n_fn memfill_n {};
+
+		// Comparing the elements of [i, i + n) with a const T& using == is
+		// equivalent to comparing object representations.
+		template<class I, class T>
+		META_CONCEPT MemFindable =
+			MemIterator<I> && Integral<iter_value_t<I>> && Integral<T>;
+
+		// Ordering the elements of [i, i + n) with comp and proj is
+		// ordering their values with < or >, which the kernels of
+		// detail::simd::find_extrema know how to do.
+		template<class I, class Comp, class Proj>
+		META_CONCEPT MemOrderable =
+			MemIterator<I> && simd::is_orderable_lane<iter_value_t<I>> &&
+			(IsFn<Comp, less> || IsFn<Comp, greater>) && IsFn<Proj, identity>;
+
+		// Integer comparison converts both operands to their common type,
+		// which is injective on each operand type: an element equals value
+		// iff it equals V(value) and V(value) compares equal to value.
+		template<class V, Integral T>
+		constexpr bool __representable_as(const T& value) noexcept {
+			using C = std::common_type_t<V, T>;
+			return static_cast<C>(static_cast<V>(value)) == static_cast<C>(value);
+		}
+
+		struct __memfind_n_fn {
+			// Returns an iterator to the first element of the n elements
+			// starting at first that equals value, or first + n.
+			template<class I, class T>
+			requires MemFindable<I, T>
+			I operator()(I first, iter_difference_t<I> n, const T& value) const noexcept {
+				using V = iter_value_t<I>;
+				STL2_EXPECT(n >= 0);
+				if (n <= 0 || !__representable_as<V>(value)) return first + n;
+				const V* const p = std::addressof(*first);
+				return first + (simd::find_eq(p, p + n, static_cast<V>(value)) - p);
+			}
+		};
+
+		inline constexpr __memfind_n_fn memfind_n {};
+
+		struct __memcount_n_fn {
+			// Returns the number of the n elements starting at first that
+			// equal value.
+			template<class I, class T>
+			requires MemFindable<I, T>
+			iter_difference_t<I>
+			operator()(I first, iter_difference_t<I> n, const T& value) const noexcept {
+				using V = iter_value_t<I>;
+				STL2_EXPECT(n >= 0);
+				if (n <= 0 || !__representable_as<V>(value)) return 0;
+				const V* const p = std::addressof(*first);
+				return static_cast<iter_difference_t<I>>(
+					simd::count_eq(p, p + n, static_cast<V>(value)));
+			}
+		};
+
+		inline constexpr __memcount_n_fn memcount_n {};
+
+		// Comparing the elements of [i1, i1 + n) with those of [i2, i2 + n)
+		// using == is equivalent to comparing object representations.
+		template<class I1, class I2>
+		META_CONCEPT MemComparable =
+			MemIterator<I1> && MemIterator<I2> &&
+			Same<iter_value_t<I1>, iter_value_t<I2>> &&
+			(Integral<iter_value_t<I1>> || Same<iter_value_t<I1>, std::byte>);
+
+		struct __memequal_n_fn {
+			// Returns true iff each of the n elements starting at first1
+			// equals the corresponding element starting at first2.
+			template<class I1, class I2>
+			requires MemComparable<I1, I2>
+			bool operator()(I1 first1, I2 first2, iter_difference_t<I1> n) const noexcept {
+				STL2_EXPECT(n >= 0);
+				return n <= 0 || std::memcmp(std::addressof(*first1), std::addressof(*first2),
+					static_cast<std::size_t>(n) * sizeof(iter_value_t<I1>)) == 0;
+			}
+		};
+
+		inline constexpr __memequal_n_fn memequal_n {};
+
+		struct __memmismatch_n_fn {
+			// Returns the least k in [0, n) for which first1[k] does not equal
+			// first2[k], or n if there is none.
+			template<class I1, class I2>
+			requires MemComparable<I1, I2>
+			iter_difference_t<I1>
+			operator()(I1 first1, I2 first2, iter_difference_t<I1> n) const noexcept {
+				STL2_EXPECT(n >= 0);
+				if (n <= 0) return 0;
+				constexpr std::size_t size = sizeof(iter_value_t<I1>);
+				const auto offset = simd::mismatch_bytes(std::addressof(*first1),
+					std::addressof(*first2), static_cast<std::size_t>(n) * size);
+				return static_cast<iter_difference_t<I1>>(offset / size);
+			}
+		};
+
+		inline constexpr __memmismatch_n_fn memmismatch_n {};
+
+		template<class Comp> struct __cmp_op {};
+		template<> struct __cmp_op<equal_to>
+		: std::integral_constant<simd::cmp_op, simd::cmp_op::eq> {};
+		template<> struct __cmp_op<not_equal_to>
+		: std::integral_constant<simd::cmp_op, simd::cmp_op::ne> {};
+		template<> struct __cmp_op<less>
+		: std::integral_constant<simd::cmp_op, simd::cmp_op::lt> {};
+		template<> struct __cmp_op<greater>
+		: std::integral_constant<simd::cmp_op, simd::cmp_op::gt> {};
+		template<> struct __cmp_op<less_equal>
+		: std::integral_constant<simd::cmp_op, simd::cmp_op::le> {};
+		template<> struct __cmp_op<greater_equal>
+		: std::integral_constant<simd::cmp_op, simd::cmp_op::ge> {};
+
+		template<class Pred, class V>
+		inline constexpr bool __lanewise_predicate = false;
+		template<class Comp, class V>
+		requires requires { __cmp_op<Comp>::value; }
+		inline constexpr bool __lanewise_predicate<ext::compare_to<Comp, V>, V> = true;
+
+		// Evaluating pred(proj(x)) for the elements x of [i, i + n) is
+		// comparing them with a constant of their own type, which the
+		// kernels of detail::simd::filter know how to do.
+		template<class I, class Pred, class Proj>
+		META_CONCEPT MemFilterable =
+			MemIterator<I> && simd::is_orderable_lane<iter_value_t<I>> &&
+			IsFn<Proj, identity> &&
+			__lanewise_predicate<meta::_t<__unwrap_fn<__uncvref<Pred>>>, iter_value_t<I>>;
+
+		// Unwraps pred, which may be a reference_wrapper.
+		template<bool Keep, class V, class Pred>
+		std::size_t __memfilter(const V* in, std::size_t n, V* out,
+			const Pred& pred) noexcept
+		{
+			using P = meta::_t<__unwrap_fn<__uncvref<Pred>>>;
+			const P& cmp = pred;
+			return simd::filter<__cmp_op<decltype(cmp.comp)>::value, Keep>(
+				in, n, out, cmp.value);
+		}
+
+		// Moves the elements x of the n starting at first for which
+		// bool(pred(x)) == Keep to the front of the range, preserving
+		// their order. Returns the end of the elements moved.
+		template<bool Keep, class I, class Pred>
+		requires MemFilterable<I, Pred, identity>
+		I memfilter_n(I first, iter_difference_t<I> n, const Pred& pred) noexcept {
+			STL2_EXPECT(n >= 0);
+			if (n <= 0) return first;
+			const auto p = std::addressof(*first);
+			return first + static_cast<iter_difference_t<I>>(
+				__memfilter<Keep>(p, static_cast<std::size_t>(n), p, pred));
+		}
+
+		// Copies the elements x of the n starting at first for which
+		// bool(pred(x)) == Keep to result, in order. Returns the end of
+		// the elements copied. The kernel may write as many elements as it
+		// reads, so they are staged in a buffer.
+		template<bool Keep, class I, class O, class Pred>
+		requires MemFilterable<I, Pred, identity> && MemCopyable<I, O>
+		O memfilter_copy_n(I first, iter_difference_t<I> n, O result,
+			const Pred& pred) noexcept
+		{
+			using V = iter_value_t<I>;
+			constexpr std::size_t buffer_size = 1024 / sizeof(V);
+			STL2_EXPECT(n >= 0);
+			if (n <= 0) return result;
+			const V* p = std::addressof(*first);
+			V buffer[buffer_size];
+			for (auto remaining = static_cast<std::size_t>(n); remaining > 0;) {
+				const std::size_t count = remaining < buffer_size ? remaining : buffer_size;
+				const std::size_t k = __memfilter<Keep>(p, count, buffer, pred);
+				if (k > 0) {
+					std::memcpy(std::addressof(*result), buffer, k * sizeof(V));
+					result += static_cast<iter_difference_t<O>>(k);
+				}
+				p += count;
+				remaining -= count;
+			}
+			return result;
+		}
+
+		// Ranges of I1 and I2 ordered by comp and proj1/proj2 are ranges of
+		// integers sorted by <, which the kernels of detail::simd::intersect
+		// know how to merge.
+		template<class I1, class I2, class Comp, class Proj1, class Proj2>
+		META_CONCEPT MemSetOperable =
+			MemIterator<I1> && MemIterator<I2> &&
+			Same<iter_value_t<I1>, iter_value_t<I2>> &&
+			Integral<iter_value_t<I1>> && IsFn<Comp, less> &&
+			IsFn<Proj1, identity> && IsFn<Proj2, identity>;
+
+		// Copies the elements of the n1 starting at first1 that are also
+		// among the n2 starting at first2 to result, as set_intersection
+		// does. Returns where set_intersection would stop in each range,
+		// and the end of the elements copied.
+		template<class I1, class I2, class O>
+		requires MemSetOperable<I1, I2, less, identity, identity> &&
+			IndirectlyCopyable<I1, O>
+		__in_in_out_result<I1, I2, O>
+		memintersect_n(I1 first1, iter_difference_t<I1> n1,
+			I2 first2, iter_difference_t<I2> n2, O result)
+		{
+			STL2_EXPECT(n1 >= 0);
+			STL2_EXPECT(n2 >= 0);
+			std::size_t i = 0, j = 0;
+			if (n1 > 0 && n2 > 0) {
+				auto emit = [&](std::size_t k) {
+					*result = *(first1 + static_cast<iter_difference_t<I1>>(k));
+					++result;
+				};
+				simd::intersect(std::addressof(*first1), static_cast<std::size_t>(n1),
+					std::addressof(*first2), static_cast<std::size_t>(n2), i, j, emit);
+			}
+			return {first1 + static_cast<iter_difference_t<I1>>(i),
+				first2 + static_cast<iter_difference_t<I2>>(j), std::move(result)};
+		}
+
+		// Returns true iff each of the n2 elements starting at first2 can
+		// be matched with a distinct equal element among the n1 starting at
+		// first1, as includes does.
+		template<class I1, class I2>
+		requires MemSetOperable<I1, I2, less, identity, identity>
+		bool memincludes_n(I1 first1, iter_difference_t<I1> n1,
+			I2 first2, iter_difference_t<I2> n2) noexcept
+		{
+			STL2_EXPECT(n1 >= 0);
+			STL2_EXPECT(n2 >= 0);
+			if (n2 <= 0) return true;
+			if (n1 <= 0) return false;
+			return simd::includes(std::addressof(*first1), static_cast<std::size_t>(n1),
+				std::addressof(*first2), static_cast<std::size_t>(n2));
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -33,6 +33,13 @@ STL2_OPEN_NAMESPACE {
 		operator()(I1 first1, S1 last1, I2 first2, S2 last2, O result,
 			Comp comp = {}, Proj1 proj1 = {}, Proj2 proj2 = {}) const
 		{
+			if constexpr (RandomAccessIterator<I1> && SizedSentinel<S1, I1> &&
+				RandomAccessIterator<I2> && SizedSentinel<S2, I2>)
+			{
+				gallop_merge(first1, iter_difference_t<I1>(last1 - first1),
+					first2, iter_difference_t<I2>(last2 - first2), result,
+					comp, proj1, proj2);
+			}
 			while (true) {
 				if (first1 == last1) {
 					auto cresult = copy(std::move(first2), std::move(last2), std::move(result));
@@ -48,12 +55,12 @@ STL2_OPEN_NAMESPACE {
 				}
 				iter_reference_t<I1>&& v1 = *first1;
 				iter_reference_t<I2>&& v2 = *first2;
-				if (__stl2::invoke(comp, __stl2::invoke(proj1, v1), __stl2::invoke(proj2, v2))) {
-					*result = std::forward<iter_reference_t<I1>>(v1);
-					++first1;
-				} else {
+				if (__stl2::invoke(comp, __stl2::invoke(proj2, v2), __stl2::invoke(proj1, v1))) {
 					*result = std::forward<iter_reference_t<I2>>(v2);
 					++first2;
+				} else {
+					*result = std::forward<iter_reference_t<I1>>(v1);
+					++first1;
 				}
 				++result;
 			}
@@ -70,6 +77,109 @@ STL2_OPEN_NAMESPACE {
 			return (*this)(begin(r1), end(r1), begin(r2), end(r2),
 				std::move(result), __stl2::ref(comp), __stl2::ref(proj1), __stl2::ref(proj2));
 		}
+	private:
+		// Galloping is entered once one input has supplied this many
+		// consecutive elements, and left once neither gallop finds a run
+		// this long.
+		static constexpr int gallop_threshold = 7;
+
+		// Returns the length of the prefix of the n elements starting at
+		// first that satisfy pred, which holds for a prefix of them:
+		// exponential search from the front, then binary search within
+		// the last step. Costs O(log k) applications of pred for a result
+		// of k.
+		template<RandomAccessIterator I, class Pred>
+		static constexpr iter_difference_t<I>
+		gallop(I first, iter_difference_t<I> n, Pred pred) {
+			using D = iter_difference_t<I>;
+			D lo = 0; // pred holds for [first, first + lo)
+			D step = 1;
+			while (step <= n - lo && pred(first[lo + step - 1])) {
+				lo += step;
+				step *= 2;
+			}
+			D hi = step <= n - lo ? lo + step - 1 : n;
+			while (lo < hi) {
+				D mid = lo + (hi - lo) / 2;
+				if (pred(first[mid])) {
+					lo = mid + 1;
+				} else {
+					hi = mid;
+				}
+			}
+			return lo;
+		}
+
+		// Merges elements one at a time until one input wins
+		// min_gallop times in a row, then alternately gallops through
+		// each input for the stretch that precedes the other's head,
+		// copying it in bulk. min_gallop adapts as in Timsort: it
+		// shrinks while galloping pays off and grows when it does not,
+		// so inputs that interleave finely stay in the cheap loop.
+		// Leaves first1 or first2 at its end; the caller copies the rest
+		// of the other.
+		template<class I1, class I2, class O, class Comp, class Proj1, class Proj2>
+		static constexpr void gallop_merge(I1& first1, iter_difference_t<I1> n1,
+			I2& first2, iter_difference_t<I2> n2, O& result,
+			Comp& comp, Proj1& proj1, Proj2& proj2)
+		{
+			// Elements of the first input that go before *first2.
+			auto before2 = [&](auto&& e1) {
+				return !__stl2::invoke(comp, __stl2::invoke(proj2, *first2),
+					__stl2::invoke(proj1, std::forward<decltype(e1)>(e1)));
+			};
+			// Elements of the second input that go before *first1.
+			auto before1 = [&](auto&& e2) {
+				return __stl2::invoke(comp,
+					__stl2::invoke(proj2, std::forward<decltype(e2)>(e2)),
+					__stl2::invoke(proj1, *first1));
+			};
+			int min_gallop = gallop_threshold;
+			while (n1 != 0 && n2 != 0) {
+				int run1 = 0, run2 = 0;
+				do {
+					iter_reference_t<I1>&& v1 = *first1;
+					iter_reference_t<I2>&& v2 = *first2;
+					if (__stl2::invoke(comp, __stl2::invoke(proj2, v2), __stl2::invoke(proj1, v1))) {
+						*result = std::forward<iter_reference_t<I2>>(v2);
+						++first2;
+						--n2;
+						++run2;
+						run1 = 0;
+					} else {
+						*result = std::forward<iter_reference_t<I1>>(v1);
+						++first1;
+						--n1;
+						++run1;
+						run2 = 0;
+					}
+					++result;
+					if (n1 == 0 || n2 == 0) return;
+				} while (run1 < min_gallop && run2 < min_gallop);
+
+				while (true) {
+					auto k1 = gallop(first1, n1, before2);
+					auto r1 = copy(first1, first1 + k1, std::move(result));
+					first1 = std::move(r1.in);
+					result = std::move(r1.out);
+					n1 -= k1;
+					if (n1 == 0) return;
+
+					auto k2 = gallop(first2, n2, before1);
+					auto r2 = copy(first2, first2 + k2, std::move(result));
+					first2 = std::move(r2.in);
+					result = std::move(r2.out);
+					n2 -= k2;
+					if (n2 == 0) return;
+
+					if (k1 < gallop_threshold && k2 < gallop_threshold) {
+						++min_gallop;
+						break;
+					}
+					if (min_gallop > 1) --min_gallop;
+				}
+			}
+		}
 	};
 
 	inline constexpr __merge_fn merge {};
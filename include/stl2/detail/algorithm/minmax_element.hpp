@@ -16,6 +16,8 @@
 #ifndef STL2_DETAIL_ALGORITHM_MINMAX_ELEMENT_HPP
 #define STL2_DETAIL_ALGORITHM_MINMAX_ELEMENT_HPP
 
+#include <memory>
+#include <stl2/detail/algorithm/memops.hpp>
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/dangling.hpp>
@@ -30,6 +32,23 @@ STL2_OPEN_NAMESPACE {
 		constexpr minmax_result<I>
 		operator()(I first, S last, Comp comp = {}, Proj proj = {}) const
 		{
+			if constexpr (SizedSentinel<S, I> && detail::MemOrderable<I, Comp, Proj>) {
+				if (!detail::is_constant_evaluated() && first != last) {
+					// The first least element and the last greatest.
+					const auto p = std::addressof(*first);
+					const auto n = last - first;
+					detail::simd::extrema<iter_value_t<I>> e{};
+					if (detail::simd::find_extrema(p, p + n, e)) {
+						const bool is_less = detail::IsFn<Comp, less>;
+						const auto& least = is_less ? e.min : e.max;
+						const auto& greatest = is_less ? e.max : e.min;
+						return {
+							first + (detail::simd::find_value(p, p + n, least) - p),
+							first + (detail::simd::rfind_value(p, p + n, greatest) - p)
+						};
+					}
+				}
+			}
 			minmax_result<I> result{first, first};
 			if (first == last || ++first == last) return result;
 
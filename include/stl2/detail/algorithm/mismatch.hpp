@@ -12,6 +12,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_MISMATCH_HPP
 #define STL2_DETAIL_ALGORITHM_MISMATCH_HPP
 
+#include <stl2/detail/algorithm/memops.hpp>
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/primitives.hpp>
@@ -32,6 +33,17 @@ STL2_OPEN_NAMESPACE {
 		operator()(I1 first1, S1 last1, I2 first2, S2 last2, Pred pred = {},
 			Proj1 proj1 = {}, Proj2 proj2 = {}) const
 		{
+			if constexpr (SizedSentinel<S1, I1> && SizedSentinel<S2, I2> &&
+				detail::MemComparable<I1, I2> && detail::IsFn<Pred, equal_to> &&
+				detail::IsFn<Proj1, identity> && detail::IsFn<Proj2, identity>)
+			{
+				if (!detail::is_constant_evaluated()) {
+					const auto n1 = last1 - first1;
+					const auto n2 = static_cast<iter_difference_t<I1>>(last2 - first2);
+					const auto k = detail::memmismatch_n(first1, first2, n1 < n2 ? n1 : n2);
+					return {first1 + k, first2 + static_cast<iter_difference_t<I2>>(k)};
+				}
+			}
 			while (true) {
 				if (first1 == last1) break;
 				if (first2 == last2) break;
@@ -13,6 +13,7 @@
 #define STL2_DETAIL_ALGORITHM_MOVE_HPP
 
 #include <stl2/detail/algorithm/copy.hpp>
+#include <stl2/detail/algorithm/memops.hpp>
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/range/primitives.hpp>
 
@@ -28,6 +29,13 @@ STL2_OPEN_NAMESPACE {
 		requires IndirectlyMovable<I, O>
 		constexpr move_result<I, O>
 		operator()(I first, S last, O result) const {
+			if constexpr (SizedSentinel<S, I> && detail::MemMovable<I, O>) {
+				if (!detail::is_constant_evaluated()) {
+					auto n = iter_difference_t<I>(last - first);
+					result = detail::memmove_n(first, n, std::move(result));
+					return {first + n, std::move(result)};
+				}
+			}
 			for (; first != last; (void) ++first, (void) ++result) {
 				*result = iter_move(first);
 			}
@@ -50,10 +58,8 @@ STL2_OPEN_NAMESPACE {
 			requires IndirectlyMovable<I, O>
 			constexpr move_result<I, O>
 			operator()(I first, S last, O result) const {
-				for (; first != last; (void) ++first, (void) ++result) {
-					*result = iter_move(first);
-				}
-				return {std::move(first), std::move(result)};
+				return __stl2::move(std::move(first), std::move(last),
+					std::move(result));
 			}
 
 			template<InputRange R, class O>
@@ -71,6 +77,19 @@ STL2_OPEN_NAMESPACE {
 			requires IndirectlyMovable<I1, I2>
 			constexpr move_result<I1, I2>
 			operator()(I1 first1, S1 last1, I2 first2, S2 last2) const {
+				if constexpr (SizedSentinel<S1, I1> && SizedSentinel<S2, I2> &&
+					detail::MemMovable<I1, I2>)
+				{
+					if (!detail::is_constant_evaluated()) {
+						auto n = iter_difference_t<I1>(last1 - first1);
+						auto n2 = iter_difference_t<I2>(last2 - first2);
+						if (static_cast<iter_difference_t<I1>>(n2) < n) {
+							n = static_cast<iter_difference_t<I1>>(n2);
+						}
+						first2 = detail::memmove_n(first1, n, std::move(first2));
+						return {first1 + n, std::move(first2)};
+					}
+				}
 				while (true) {
 					if (first1 == last1) break;
 					if (first2 == last2) break;
@@ -12,6 +12,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_MOVE_BACKWARD_HPP
 #define STL2_DETAIL_ALGORITHM_MOVE_BACKWARD_HPP
 
+#include <stl2/detail/algorithm/memops.hpp>
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/range/primitives.hpp>
 
@@ -29,6 +30,13 @@ STL2_OPEN_NAMESPACE {
 		constexpr move_backward_result<I1, I2>
 		operator()(I1 first, S1 s, I2 result) const {
 			auto last = next(first, std::move(s));
+			if constexpr (detail::MemMovable<I1, I2>) {
+				if (!detail::is_constant_evaluated()) {
+					result = detail::memmove_backward_n(last, last - first,
+						std::move(result));
+					return {std::move(last), std::move(result)};
+				}
+			}
 			auto i = last;
 			while (i != first) {
 				*--result = iter_move(--i);
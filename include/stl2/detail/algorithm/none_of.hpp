@@ -13,7 +13,9 @@
 #define STL2_DETAIL_ALGORITHM_NONE_OF_HPP
 
 #include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/execution.hpp>
 #include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/range/primitives.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////
 // none_of [alg.none_of]
@@ -38,6 +40,30 @@ STL2_OPEN_NAMESPACE {
 			return (*this)(begin(r), end(r), __stl2::ref(pred),
 				__stl2::ref(proj));
 		}
+
+		/// Extension: parallel none_of
+		///
+		template<RandomAccessIterator I, SizedSentinel<I> S, class Proj = identity,
+			IndirectUnaryPredicate<projected<I, Proj>> Pred>
+		bool operator()(const ext::parallel_policy& policy, I first, S last,
+			Pred pred, Proj proj = {}) const
+		{
+			const auto n = iter_difference_t<I>(last - first);
+			return detail::parallel_find(policy, n, [&](auto i) {
+				return bool(__stl2::invoke(pred, __stl2::invoke(proj, first[i])));
+			}, true) == n;
+		}
+
+		template<RandomAccessRange R, class Proj = identity,
+			IndirectUnaryPredicate<projected<iterator_t<R>, Proj>> Pred>
+		requires SizedRange<R>
+		bool operator()(const ext::parallel_policy& policy, R&& r, Pred pred,
+			Proj proj = {}) const
+		{
+			auto first = begin(r);
+			return (*this)(policy, first, first + distance(r), __stl2::ref(pred),
+				__stl2::ref(proj));
+		}
 	};
 
 	inline constexpr __none_of_fn none_of {};
@@ -22,25 +22,56 @@
 #ifndef STL2_DETAIL_ALGORITHM_NTH_ELEMENT_HPP
 #define STL2_DETAIL_ALGORITHM_NTH_ELEMENT_HPP
 
+#include <utility>
+#include <vector>
+#include <stl2/detail/algorithm/block_partition.hpp>
+#include <stl2/detail/algorithm/max.hpp>
+#include <stl2/detail/algorithm/min.hpp>
 #include <stl2/detail/algorithm/min_element.hpp>
+#include <stl2/detail/algorithm/partition.hpp>
 #include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/execution.hpp>
 #include <stl2/detail/range/primitives.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // nth_element [alg.nth.element]
 //
+// Introselect: quickselect with median-of-three pivots, or for long ranges
+// pivots sampled after Floyd and Rivest, falling back to median of medians
+// when the range stops shrinking fast enough. Runs of elements equivalent
+// to the pivot are split off by a second partition, so the worst case is
+// linear even when most elements are equivalent.
+//
 STL2_OPEN_NAMESPACE {
 	struct __nth_element_fn : private __niebloid {
-		// TODO: refactor this monstrosity.
 		template<RandomAccessIterator I, Sentinel<I> S, class Comp = less,
 			class Proj = identity>
 		requires Sortable<I, Comp, Proj>
 		constexpr I operator()(I first, I nth, S last, Comp comp = {},
 			Proj proj = {}) const
 		{
-			constexpr iter_difference_t<I> limit = 7;
-			static_assert(limit >= 3);
+			I end = next(nth, last);
+			introselect(std::move(first), std::move(nth), end, comp, proj);
+			return end;
+		}
+
+		template<RandomAccessRange Rng, class Comp = less, class Proj = identity>
+		requires Sortable<iterator_t<Rng>, Comp, Proj>
+		constexpr safe_iterator_t<Rng> operator()(Rng&& rng, iterator_t<Rng> nth,
+			Comp comp = {}, Proj proj = {}) const
+		{
+			return (*this)(begin(rng), std::move(nth), end(rng),
+				__stl2::ref(comp), __stl2::ref(proj));
+		}
 
+		/// Extension: parallel nth_element
+		///
+		template<RandomAccessIterator I, Sentinel<I> S, class Comp = less,
+			class Proj = identity>
+		requires Sortable<I, Comp, Proj>
+		I operator()(const ext::parallel_policy& policy, I first, I nth, S last,
+			Comp comp = {}, Proj proj = {}) const
+		{
 			auto pred = [&](auto&& lhs, auto&& rhs) -> bool {
 				return __stl2::invoke(comp,
 					__stl2::invoke(proj, static_cast<decltype(lhs)>(lhs)),
@@ -49,180 +80,315 @@ STL2_OPEN_NAMESPACE {
 
 			I end_orig = next(nth, last);
 			I end = end_orig;
-			while (true) {
-				if (nth == end) return end_orig;
+			const auto chunk = static_cast<iter_difference_t<I>>(
+				detail::parallel_chunk(policy, static_cast<std::ptrdiff_t>(end - first)));
+			// Give up on parallel partitioning after 2 log2(n) rounds: the
+			// pivots are not good enough.
+			iter_difference_t<I> rounds = 0;
+			for (auto n = end - first; n > 1; n /= 2) rounds += 2;
 
-				iter_difference_t<I> len = end - first;
-				STL2_EXPECT(len >= 0);
-				switch (len) {
-				case 0:
-				case 1:
-					return end_orig;
-				case 2:
-					if (pred(*--end, *first)) iter_swap(first, end);
-					return end_orig;
-				case 3:
-					{
-						I m = first;
-						sort3(first, ++m, --end, comp, proj);
-						return end_orig;
-					}
-				default: break;
+			while (end - first > chunk && nth != end && rounds-- > 0) {
+				// Partition [first, pivot) into [first, lo) < *pivot,
+				// [lo, hi) equivalent to *pivot when nth is not in the first
+				// part, and [hi, pivot) > *pivot; then put *pivot at hi.
+				I pivot = end - 1;
+				I m = first + (end - first) / 2;
+				sort3(first, m, pivot, comp, proj);
+				iter_swap(m, pivot);
+				I lo = parallel_partition(first, pivot, chunk,
+					[&](auto&& x) { return pred(x, *pivot); });
+				I hi = lo;
+				if (!(nth < lo)) {
+					hi = parallel_partition(lo, pivot, chunk,
+						[&](auto&& x) { return !pred(*pivot, x); });
 				}
-				if (len <= limit) {
-					selection_sort(first, end, comp, proj);
+				if (hi != pivot) iter_swap(hi, pivot);
+
+				if (nth < lo) {
+					end = lo;
+				} else if (!(hi < nth)) {
 					return end_orig;
+				} else {
+					first = ++hi;
 				}
-				// Post: len > limit
+			}
+			(*this)(first, nth, end, __stl2::ref(comp), __stl2::ref(proj));
+			return end_orig;
+		}
 
-				I m = first + len / 2;
-				I lm1 = end;
-				unsigned n_swaps = sort3(first, m, --lm1, comp, proj);
-				// Post: *m is median
+		template<RandomAccessRange Rng, class Comp = less, class Proj = identity>
+		requires Sortable<iterator_t<Rng>, Comp, Proj>
+		safe_iterator_t<Rng> operator()(const ext::parallel_policy& policy,
+			Rng&& rng, iterator_t<Rng> nth, Comp comp = {}, Proj proj = {}) const
+		{
+			return (*this)(policy, begin(rng), std::move(nth), end(rng),
+				__stl2::ref(comp), __stl2::ref(proj));
+		}
+	private:
+		// Partitions no longer than this are selection sorted.
+		static constexpr std::ptrdiff_t selection_sort_threshold = 7;
+		// Partitions longer than this take their pivot from a sample.
+		static constexpr std::ptrdiff_t sample_threshold = 600;
+
+		// Partitions [first, end) until nth is in place, around the median
+		// of three or, for long ranges, a pivot selected from a sample.
+		// Unless every two partitions at least halve the range, the rest is
+		// left to median_of_medians, so the worst case is linear.
+		template<RandomAccessIterator I, class Comp, class Proj>
+		requires Sortable<I, Comp, Proj>
+		static constexpr void introselect(I first, I nth, I end, Comp& comp, Proj& proj) {
+			using D = iter_difference_t<I>;
+			D checkpoint = 0;
+			for (bool check = true; nth != end; check = !check) {
+				const D n = end - first;
+				if (n <= selection_sort_threshold) {
+					if (n > 1) selection_sort(first, end, comp, proj);
+					return;
+				}
+				if (check) {
+					if (checkpoint != 0 && n > checkpoint / 2) {
+						median_of_medians(first, nth, end, comp, proj);
+						return;
+					}
+					checkpoint = n;
+				}
 
-				// partition [first, m) < *m and *m <= [m, end)
-				//(this inhibits tossing elements equivalent to m around unnecessarily)
-				I i = first;
-				I j = lm1;
-				// j points beyond range to be tested, *lm1 is known to be <= *m
-				// The search going up is known to be guarded but the search coming down isn't.
-				// Prime the downward search with a guard.
-				if (!pred(*i, *m)) {  // if *first == *m
-					// *first == *m, *first doesn't go in first part
-					// manually guard downward moving j against i
-					bool restart = false;
-					while (true) {
-						if (i == --j) {
-							// *first == *m, *m <= all other elements
-							// Parition instead into [first, i) == *first and *first < [i, end)
-							++i;  // first + 1
-							j = end;
-							if (!pred(*first, *--j)) {  // we need a guard if *first == *(end-1)
-								while (true) {
-									if (i == j) {
-										return end_orig;  // [first, end) all equivalent elements
-									}
-									if (pred(*first, *i)) {
-										iter_swap(i, j);
-										++n_swaps;
-										++i;
-										break;
-									}
-									++i;
-								}
-							}
-							// [first, i) == *first and *first < [j, end) and j == end - 1
-							if (i == j) return end_orig;
+				I pivot = first + n / 2;
+				if (n > sample_threshold) {
+					pivot = sample_pivot(first, nth, end, comp, proj);
+				} else {
+					sort3(first, pivot, end - 1, comp, proj);
+				}
+				if (narrow(first, nth, end, pivot, comp, proj, n / 8)) return;
+			}
+		}
 
-							while (true) {
-								while (!pred(*first, *i)) { ++i; }
-								while (pred(*first, *--j)) {}
-								if (i >= j) break;
-								iter_swap(i, j);
-								++n_swaps;
-								++i;
-							}
-							// [first, i) == *first and *first < [i, end)
-							// The first part is sorted,
-							if (nth < i) return end_orig;
+		// Floyd and Rivest, "Algorithm 489: The Algorithm SELECT" (1975):
+		// selects nth's rank within a window of about n^(2/3) / 2 elements
+		// around nth, offset a little toward the middle of the range, so
+		// that the pivot is very likely close to the nth smallest and on
+		// the side of it that leaves the shorter part to select from.
+		template<RandomAccessIterator I, class Comp, class Proj>
+		requires Sortable<I, Comp, Proj>
+		static constexpr I sample_pivot(I first, I nth, I end, Comp& comp, Proj& proj) {
+			using D = iter_difference_t<I>;
+			const D n = end - first;
+			const D k = nth - first;
+			D log2n = 0;
+			for (D m = n; m > 1; m /= 2) ++log2n;
+			const D s = n / icbrt(n) / 2;
+			D sd = isqrt(static_cast<D>(0.693 * static_cast<double>(log2n) *
+				static_cast<double>(s) * static_cast<double>(n - s) /
+				static_cast<double>(n))) / 2;
+			if (k < n - k) sd = -sd;
+			D l = k - static_cast<D>(static_cast<double>(k + 1) * static_cast<double>(s) /
+				static_cast<double>(n)) + sd;
+			D r = k + static_cast<D>(static_cast<double>(n - k - 1) * static_cast<double>(s) /
+				static_cast<double>(n)) + sd + 1;
+			l = __stl2::max(D{0}, __stl2::min(l, k));
+			r = __stl2::min(n, __stl2::max(r, k + 1));
+			introselect(first + l, nth, first + r, comp, proj);
+			return nth;
+		}
 
-							// nth_element the second part
-							// nth_element<C>(i, nth, end, comp);
-							restart = true;
-							break;
-						}
-						if (pred(*j, *m)) {
-							iter_swap(i, j);
-							++n_swaps;
-							break;  // found guard for downward moving j, now use unguarded partition
-						}
-					}
-					if (restart) {
-						first = i;
-						continue;
-					}
+		// Blum, Floyd, Pratt, Rivest and Tarjan, "Time Bounds for
+		// Selection" (1973): the median of the medians of groups of five
+		// has at least 3/10 of the range on each side, so each partition
+		// leaves at most 7/10 of it.
+		template<RandomAccessIterator I, class Comp, class Proj>
+		requires Sortable<I, Comp, Proj>
+		static constexpr void median_of_medians(I first, I nth, I end, Comp& comp,
+			Proj& proj)
+		{
+			using D = iter_difference_t<I>;
+			while (nth != end) {
+				const D n = end - first;
+				if (n <= selection_sort_threshold) {
+					if (n > 1) selection_sort(first, end, comp, proj);
+					return;
 				}
-				++i;
-				// j points beyond range to be tested, *lm1 is known to be <= *m
-				// if not yet partitioned...
-				if (i < j) {
-					// known that *(i - 1) < *m
-					while (true) {
-						// m still guards upward moving i
-						while (pred(*i, *m)) { ++i; }
-						// It is now known that a guard exists for downward moving j
-						while (!pred(*--j, *m)) {}
-						if (i >= j) break;
-						iter_swap(i, j);
-						++n_swaps;
-						// It is known that m != j
-						// If m just moved, follow it
-						if (m == i) m = j;
-						++i;
-					}
+				I medians = first;
+				for (I group = first; end - group >= 5; group += 5) {
+					selection_sort(group, group + 5, comp, proj);
+					iter_swap(medians, group + 2);
+					++medians;
 				}
-				// [first, i) < *m and *m <= [i, end)
-				if (i != m && pred(*m, *i)) {
-					iter_swap(i, m);
-					++n_swaps;
+				I pivot = first + (medians - first) / 2;
+				median_of_medians(first, pivot, medians, comp, proj);
+				if (narrow(first, nth, end, pivot, comp, proj, n)) return;
+			}
+		}
+
+		// Partitions [first, end) around *pivot into [first, lo) less than
+		// it, *lo equivalent and [lo + 1, end) not less; then, if nth is in
+		// the last part and fewer than split elements are less than the
+		// pivot - as when many are equivalent to it - splits the last part
+		// into those equivalent to the pivot and those greater. Narrows
+		// [first, end) to the part that contains nth, or returns true if
+		// that part is equivalent to the pivot and so nth is in place.
+		template<RandomAccessIterator I, class Comp, class Proj>
+		requires Sortable<I, Comp, Proj>
+		static constexpr bool narrow(I& first, I nth, I& end, I pivot, Comp& comp,
+			Proj& proj, iter_difference_t<I> split)
+		{
+			iter_swap(first, pivot);
+			I lo = partition_less(first, end, comp, proj) - 1;
+			iter_swap(first, lo);
+			// [first, lo) < *lo <= [lo + 1, end)
+			if (nth < lo) {
+				end = lo;
+				return false;
+			}
+			if (nth == lo) return true;
+			I hi = lo + 1;
+			if (lo - first < split) {
+				hi = partition_not_greater(lo, end, comp, proj);
+				// [lo, hi) == *lo < [hi, end)
+				if (nth < hi) return true;
+			}
+			first = hi;
+			return false;
+		}
+
+		// Partitions [first + 1, end) into the elements less than *first
+		// and the rest; returns the partition point.
+		template<RandomAccessIterator I, class Comp, class Proj>
+		requires Sortable<I, Comp, Proj>
+		static constexpr I partition_less(I first, I end, Comp& comp, Proj& proj) {
+			if constexpr (detail::BranchlessSortable<I, Comp, Proj>) {
+				if (!detail::is_constant_evaluated()) {
+					const iter_value_t<I> pivot = *first;
+					return partition(first + 1, end, [&](const auto& x) -> bool {
+						return __stl2::invoke(comp, x, pivot);
+					});
 				}
-				// [first, i) < *i and *i <= [i+1, end)
-				if (nth == i) return end_orig;
+			}
+			return partition(first + 1, end, [&](auto&& x) -> bool {
+				return __stl2::invoke(comp, static_cast<decltype(x)>(x),
+					__stl2::invoke(proj, *first));
+			}, __stl2::ref(proj));
+		}
 
-				if (n_swaps == 0) {
-					// We were given a perfectly partitioned sequence.  Coincidence?
-					if (nth < i) {
-						// Check for [first, i) already sorted
-						j = m = first;
-						while (true) {
-							if (++j == i) {
-								// [first, i) sorted
-								return end_orig;
-							}
-							if (pred(*j, *m)) {
-								// not yet sorted, so sort
-								break;
-							}
-							m = j;
-						}
-					} else {
-						// Check for [i, end) already sorted
-						j = m = i;
-						while (true) {
-							if (++j == end) {
-								// [i, end) sorted
-								return end_orig;
-							}
-							if (pred(*j, *m)) {
-								// not yet sorted, so sort
-								break;
-							}
-							m = j;
-						}
-					}
+		// Partitions [pivot + 1, end) into the elements not greater than
+		// *pivot and the rest; returns the partition point.
+		template<RandomAccessIterator I, class Comp, class Proj>
+		requires Sortable<I, Comp, Proj>
+		static constexpr I partition_not_greater(I pivot, I end, Comp& comp, Proj& proj) {
+			if constexpr (detail::BranchlessSortable<I, Comp, Proj>) {
+				if (!detail::is_constant_evaluated()) {
+					const iter_value_t<I> value = *pivot;
+					return partition(pivot + 1, end, [&](const auto& x) -> bool {
+						return !__stl2::invoke(comp, value, x);
+					});
 				}
+			}
+			return partition(pivot + 1, end, [&](auto&& x) -> bool {
+				return !__stl2::invoke(comp, __stl2::invoke(proj, *pivot),
+					static_cast<decltype(x)>(x));
+			}, __stl2::ref(proj));
+		}
 
-				// nth_element on range containing nth
-				if (nth < i) {
-					// nth_element<C>(first, nth, i, comp);
-					end = i;
+		// The greatest r with r * r <= x.
+		template<class D>
+		static constexpr D isqrt(D x) noexcept {
+			D r = x, y = (x + 1) / 2;
+			while (y < r) {
+				r = y;
+				y = (y + x / y) / 2;
+			}
+			return r;
+		}
+
+		// The greatest r with r * r * r <= x, for x >= 0; r * r * r is
+		// never formed, as it may overflow D.
+		template<class D>
+		static constexpr D icbrt(D x) noexcept {
+			D lo = 0, hi = x;
+			while (lo < hi) {
+				const D mid = hi - (hi - lo) / 2;
+				if (mid <= x / mid / mid) {
+					lo = mid;
 				} else {
-					// nth_element<C>(i+1, nth, end, comp);
-					first = ++i;
+					hi = mid - 1;
 				}
 			}
-			return end_orig;
+			return lo;
 		}
 
-		template<RandomAccessRange Rng, class Comp = less, class Proj = identity>
-		requires Sortable<iterator_t<Rng>, Comp, Proj>
-		constexpr safe_iterator_t<Rng> operator()(Rng&& rng, iterator_t<Rng> nth,
-			Comp comp = {}, Proj proj = {}) const
+		// Partitions [first, last) by pred, which is invoked concurrently;
+		// returns the partition point. Pieces of length chunk are
+		// partitioned in parallel, then the elements on the wrong side of
+		// the overall partition point are exchanged in parallel.
+		template<RandomAccessIterator I, class Pred>
+		requires Permutable<I>
+		static I parallel_partition(I first, I last, iter_difference_t<I> chunk,
+			Pred pred)
 		{
-			return (*this)(begin(rng), std::move(nth), end(rng),
-				__stl2::ref(comp), __stl2::ref(proj));
+			using D = iter_difference_t<I>;
+			const D n = last - first;
+			const D pieces = (n + chunk - 1) / chunk;
+			std::vector<D> mids(static_cast<std::size_t>(pieces));
+			{
+				detail::task_group tasks;
+				for (D p = 0; p < pieces; ++p) {
+					tasks.run([&, p] {
+						const D b = p * chunk;
+						const D e = __stl2::min(n, b + chunk);
+						mids[p] = partition(first + b, first + e, __stl2::ref(pred)) - first;
+					});
+				}
+				tasks.wait();
+			}
+
+			// The misplaced elements are the trues at or after the partition
+			// point and the falses before it; there are as many of each.
+			D split = 0;
+			for (D p = 0; p < pieces; ++p) {
+				split += mids[p] - p * chunk;
+			}
+			struct interval { D offset, length; };
+			std::vector<interval> falses, trues;
+			for (D p = 0; p < pieces; ++p) {
+				const D b = p * chunk;
+				const D e = __stl2::min(n, b + chunk);
+				const D f = __stl2::min(e, split);
+				if (mids[p] < f) {
+					falses.push_back({mids[p], f - mids[p]});
+				}
+				const D t = __stl2::max(b, split);
+				if (t < mids[p]) {
+					trues.push_back({t, mids[p] - t});
+				}
+			}
+
+			// Exchange the k-th misplaced false with the k-th misplaced true,
+			// in parallel over pieces of [0, misplaced).
+			D misplaced = 0;
+			for (auto& i : falses) misplaced += i.length;
+			{
+				detail::task_group tasks;
+				for (D k = 0; k < misplaced; k += chunk) {
+					tasks.run([&, k] {
+						auto seek = [](const std::vector<interval>& v, D k) {
+							std::size_t i = 0;
+							while (k >= v[i].length) k -= v[i++].length;
+							return std::pair<std::size_t, D>{i, k};
+						};
+						auto [fi, fo] = seek(falses, k);
+						auto [ti, to] = seek(trues, k);
+						for (D count = __stl2::min(chunk, misplaced - k); count > 0; --count) {
+							iter_swap(first + (falses[fi].offset + fo), first + (trues[ti].offset + to));
+							if (++fo == falses[fi].length) { ++fi; fo = 0; }
+							if (++to == trues[ti].length) { ++ti; to = 0; }
+						}
+					});
+				}
+				tasks.wait();
+			}
+			return first + split;
 		}
-	private:
+
+
 		// stable, 2-3 compares, 0-2 swaps
 		template<class I, class C, class P>
 		requires Sortable<I, C, P>
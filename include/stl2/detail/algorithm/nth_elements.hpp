@@ -0,0 +1,90 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_NTH_ELEMENTS_HPP
+#define STL2_DETAIL_ALGORITHM_NTH_ELEMENTS_HPP
+
+#include <stl2/detail/algorithm/is_sorted.hpp>
+#include <stl2/detail/algorithm/nth_element.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/range/primitives.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// nth_elements [Extension]
+//
+// Puts each element denoted by a sorted range of iterators nths in the
+// position it would occupy if [first, last) were sorted, with no element
+// between two of them out of place relative to either: the order
+// statistics at every position of nths in one pass. The middle position
+// is selected by nth_element, which splits both [first, last) and nths in
+// two; only the parts that contain a position of nths are selected from
+// further, so k positions cost O(n log k) rather than the O(n k) of k
+// separate calls.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		template<class I, class R>
+		META_CONCEPT __nth_positions =
+			RandomAccessRange<R> &&
+			ConvertibleTo<iter_reference_t<iterator_t<R>>, I>;
+
+		struct __nth_elements_fn : private __niebloid {
+			template<RandomAccessIterator I, Sentinel<I> S, class R,
+				class Comp = less, class Proj = identity>
+			requires Sortable<I, Comp, Proj> && __nth_positions<I, R>
+			constexpr I operator()(I first, S last, R&& nths, Comp comp = {},
+				Proj proj = {}) const
+			{
+				I end_orig = next(first, std::move(last));
+				STL2_EXPECT(is_sorted(nths, less{}, [](const I& i) { return i; }));
+				select(std::move(first), end_orig, begin(nths), end(nths), comp, proj);
+				return end_orig;
+			}
+
+			template<RandomAccessRange Rng, class R, class Comp = less,
+				class Proj = identity>
+			requires Sortable<iterator_t<Rng>, Comp, Proj> &&
+				__nth_positions<iterator_t<Rng>, R>
+			constexpr safe_iterator_t<Rng> operator()(Rng&& rng, R&& nths,
+				Comp comp = {}, Proj proj = {}) const
+			{
+				return (*this)(begin(rng), end(rng), std::forward<R>(nths),
+					__stl2::ref(comp), __stl2::ref(proj));
+			}
+		private:
+			template<class I, class RI, class Comp, class Proj>
+			static constexpr void select(I first, I end, RI nths_first, RI nths_last,
+				Comp& comp, Proj& proj)
+			{
+				while (nths_first != nths_last) {
+					RI mid = nths_first + (nths_last - nths_first) / 2;
+					const I nth = *mid;
+					if (nth == end) {
+						nths_last = mid;
+						continue;
+					}
+					nth_element(first, nth, end, __stl2::ref(comp), __stl2::ref(proj));
+					// [first, nth) <= *nth <= [nth + 1, end)
+					select(first, nth, nths_first, mid, comp, proj);
+					do {
+						++mid;
+					} while (mid != nths_last && I(*mid) == nth);
+					first = nth + 1;
+					nths_first = mid;
+				}
+			}
+		};
+
+		inline constexpr __nth_elements_fn nth_elements {};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -38,7 +38,7 @@ STL2_OPEN_NAMESPACE {
 						__stl2::invoke(proj, *i),
 						__stl2::invoke(proj, *first))) {
 					iter_swap(i, first);
-					detail::sift_down_n(first, len, first, __stl2::ref(comp),
+					detail::bottom_up_sift_down_n(first, len, __stl2::ref(comp),
 						__stl2::ref(proj));
 				}
 			}
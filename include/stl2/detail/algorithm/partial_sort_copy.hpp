@@ -49,7 +49,7 @@ STL2_OPEN_NAMESPACE {
 							__stl2::invoke(proj1, x),
 							__stl2::invoke(proj2, *result_first))) {
 						*result_first = std::forward<iter_reference_t<I1>>(x);
-						detail::sift_down_n(result_first, len, result_first,
+						detail::bottom_up_sift_down_n(result_first, len,
 							__stl2::ref(comp), __stl2::ref(proj2));
 					}
 				}
@@ -22,6 +22,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_PARTITION_HPP
 #define STL2_DETAIL_ALGORITHM_PARTITION_HPP
 
+#include <stl2/detail/algorithm/block_partition.hpp>
 #include <stl2/detail/algorithm/find_if_not.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/primitives.hpp>
@@ -29,6 +30,9 @@
 ///////////////////////////////////////////////////////////////////////////
 // partition [alg.partitions]
 //
+// Random access ranges of small trivially copyable elements are
+// partitioned without branching on the predicate.
+//
 STL2_OPEN_NAMESPACE {
 	struct __partition_fn : private __niebloid {
 		template<Permutable I, Sentinel<I> S, class Proj = identity,
@@ -37,6 +41,16 @@ STL2_OPEN_NAMESPACE {
 			if constexpr (BidirectionalIterator<I>) {
 				auto last = next(first, std::move(last_));
 
+				if constexpr (detail::BlockPartitionable<I>) {
+					if (!detail::is_constant_evaluated()) {
+						auto p = [&](auto&& x) -> bool {
+							return __stl2::invoke(pred,
+								__stl2::invoke(proj, static_cast<decltype(x)>(x)));
+						};
+						return detail::block_partition(std::move(first), std::move(last), p);
+					}
+				}
+
 				for (; first != last; ++first) {
 					if (!__stl2::invoke(pred, __stl2::invoke(proj, *first))) {
 						while (true) {
@@ -12,6 +12,8 @@
 #ifndef STL2_DETAIL_ALGORITHM_PARTITION_COPY_HPP
 #define STL2_DETAIL_ALGORITHM_PARTITION_COPY_HPP
 
+#include <memory>
+#include <stl2/detail/algorithm/memops.hpp>
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/primitives.hpp>
@@ -19,6 +21,9 @@
 ///////////////////////////////////////////////////////////////////////////
 // partition_copy [alg.partitions]
 //
+// Between contiguous ranges of trivially copyable elements, the elements
+// are classified a block at a time without branching on the predicate.
+//
 STL2_OPEN_NAMESPACE {
 	template<class I, class O1, class O2>
 	using partition_copy_result = __in_out_out_result<I, O1, O2>;
@@ -32,6 +37,14 @@ STL2_OPEN_NAMESPACE {
 		operator()(I first, S last, O1 out_true, O2 out_false, Pred pred,
 			Proj proj = {}) const
 		{
+			if constexpr (SizedSentinel<S, I> && detail::MemCopyable<I, O1> &&
+				detail::MemCopyable<I, O2>)
+			{
+				if (!detail::is_constant_evaluated()) {
+					return block_copy(std::move(first), std::move(last),
+						std::move(out_true), std::move(out_false), pred, proj);
+				}
+			}
 			for (; first != last; ++first) {
 				iter_reference_t<I>&& v = *first;
 				if (__stl2::invoke(pred, __stl2::invoke(proj, v))) {
@@ -58,6 +71,51 @@ STL2_OPEN_NAMESPACE {
 				std::move(out_true), std::move(out_false),
 				__stl2::ref(pred), __stl2::ref(proj));
 		}
+	private:
+		// Elements classified per block.
+		static constexpr std::ptrdiff_t block_size = 64;
+
+		// Records the offsets of the elements of each block that satisfy
+		// pred, and of those that do not, without branching on the result,
+		// then copies each group out in a tight loop.
+		template<class I, class S, class O1, class O2, class Pred, class Proj>
+		static partition_copy_result<I, O1, O2>
+		block_copy(I first, S last, O1 out_true, O2 out_false, Pred& pred,
+			Proj& proj)
+		{
+			using D = iter_difference_t<I>;
+			alignas(64) unsigned char offsets_t[block_size];
+			alignas(64) unsigned char offsets_f[block_size];
+			for (D n = last - first; n > 0;) {
+				const D count = n < block_size ? n : block_size;
+				const auto in = std::addressof(*first);
+				D num_t = 0, num_f = 0;
+				for (D i = 0; i < count; ++i) {
+					const bool b = __stl2::invoke(pred, __stl2::invoke(proj, in[i]));
+					offsets_t[num_t] = static_cast<unsigned char>(i);
+					offsets_f[num_f] = static_cast<unsigned char>(i);
+					num_t += b;
+					num_f += !b;
+				}
+				if (num_t) {
+					const auto out = std::addressof(*out_true);
+					for (D i = 0; i < num_t; ++i) {
+						out[i] = in[offsets_t[i]];
+					}
+					out_true += num_t;
+				}
+				if (num_f) {
+					const auto out = std::addressof(*out_false);
+					for (D i = 0; i < num_f; ++i) {
+						out[i] = in[offsets_f[i]];
+					}
+					out_false += num_f;
+				}
+				first += count;
+				n -= count;
+			}
+			return {std::move(first), std::move(out_true), std::move(out_false)};
+		}
 	};
 
 	inline constexpr __partition_copy_fn partition_copy {};
@@ -22,14 +22,56 @@
 #ifndef STL2_DETAIL_ALGORITHM_PARTITION_POINT_HPP
 #define STL2_DETAIL_ALGORITHM_PARTITION_POINT_HPP
 
+#include <memory>
+#include <stl2/detail/algorithm/memops.hpp>
 #include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/concepts/fundamental.hpp>
 #include <stl2/detail/iterator/counted_iterator.hpp>
 #include <stl2/detail/range/primitives.hpp>
+#include <stl2/detail/simd/config.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // partition_point [alg.partitions]
 //
 STL2_OPEN_NAMESPACE {
+	namespace detail {
+		// Comparisons are cheap enough and hard enough to predict that a
+		// binary search should avoid branching on them.
+		template<class I, class T, class Comp, class Proj>
+		META_CONCEPT BranchlessSearchable =
+			RandomAccessIterator<I> &&
+			ext::Arithmetic<iter_value_t<I>> && ext::Arithmetic<T> &&
+			(IsFn<Comp, less> || IsFn<Comp, greater>) &&
+			IsFn<Proj, identity>;
+
+		struct __branchless_partition_point_n_fn {
+			// As ext::partition_point_n, but each step selects the half to
+			// keep with a conditional move instead of a branch, so the
+			// search never mispredicts. For contiguous ranges, both
+			// candidates for the next probe are prefetched while the
+			// current one is compared.
+			template<RandomAccessIterator I, class Pred>
+			I operator()(I first, iter_difference_t<I> n, Pred pred) const {
+				STL2_EXPECT(0 <= n);
+				if (n == 0) return first;
+				while (n > 1) {
+					const auto half = n / 2;
+					if constexpr (ContiguousIterator<I>) {
+						const auto next = (n - half) / 2;
+						const auto p = std::addressof(*first);
+						simd::prefetch(p + next);
+						simd::prefetch(p + half + next);
+					}
+					first += pred(first[half]) ? half : 0;
+					n -= half;
+				}
+				return first + (pred(*first) ? 1 : 0);
+			}
+		};
+
+		inline constexpr __branchless_partition_point_n_fn branchless_partition_point_n {};
+	}
+
 	namespace ext {
 		struct __partition_point_n_fn {
 			template<ForwardIterator I, class Proj = identity,
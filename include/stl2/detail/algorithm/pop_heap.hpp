@@ -31,6 +31,7 @@
 //
 STL2_OPEN_NAMESPACE {
 	namespace detail {
+		template<std::size_t Arity>
 		struct __pop_heap_n_fn {
 			template<RandomAccessIterator I, class Proj, class Comp>
 			requires Sortable<I, Comp, Proj>
@@ -38,13 +39,15 @@ STL2_OPEN_NAMESPACE {
 			operator()(I first, iter_difference_t<I> n, Comp comp, Proj proj) const {
 				if (n > 1) {
 					iter_swap(first, first + (n - 1));
-					sift_down_n(first, n - 1, first, __stl2::ref(comp),
-						__stl2::ref(proj));
+					dary_bottom_up_sift_down_n<Arity>(first, n - 1,
+						__stl2::ref(comp), __stl2::ref(proj));
 				}
 			}
 		};
 
-		inline constexpr __pop_heap_n_fn pop_heap_n {};
+		template<std::size_t Arity>
+		inline constexpr __pop_heap_n_fn<Arity> dary_pop_heap_n {};
+		inline constexpr __pop_heap_n_fn<2> pop_heap_n {};
 	}
 
 	struct __pop_heap_fn : private __niebloid {
@@ -0,0 +1,376 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_RADIX_SORT_HPP
+#define STL2_DETAIL_ALGORITHM_RADIX_SORT_HPP
+
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/temporary_vector.hpp>
+#include <stl2/detail/algorithm/move.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/range/primitives.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// radix_sort [Extension]
+//
+// Sorts by a key projected from each element without comparing elements:
+// integers and IEEE floating-point values by numeric value (with -0.0
+// before +0.0, and NaNs ordered by sign and payload), std::arrays of
+// unsigned char or std::byte lexicographically, and keys convertible to
+// std::string_view as strings. Fixed-width keys use LSD passes over
+// temporary storage for a copy of the range, skipping passes on bytes
+// that are the same in every key; string keys use MSD passes. Like sort,
+// radix_sort is not stable.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		// radix_key<K> maps a key to an unsigned encoding whose byte-wise
+		// order, most significant byte first, is the order of the keys.
+		template<class K>
+		struct radix_key {};
+
+		template<Integral K>
+		requires (!Same<K, bool>)
+		struct radix_key<K> {
+			using encoded_type = std::make_unsigned_t<K>;
+			static constexpr std::size_t width = sizeof(K);
+
+			static constexpr encoded_type encode(K k) noexcept {
+				auto u = static_cast<encoded_type>(k);
+				if constexpr (std::is_signed_v<K>) {
+					u ^= encoded_type(1) << (CHAR_BIT * sizeof(K) - 1);
+				}
+				return u;
+			}
+			static constexpr unsigned char digit(encoded_type u, std::size_t i) noexcept {
+				return static_cast<unsigned char>(u >> (CHAR_BIT * i));
+			}
+		};
+
+		template<ext::FloatingPoint K>
+		requires std::numeric_limits<K>::is_iec559 &&
+			(sizeof(K) == sizeof(std::uint32_t) || sizeof(K) == sizeof(std::uint64_t))
+		struct radix_key<K> {
+			using encoded_type = meta::if_c<sizeof(K) == sizeof(std::uint32_t),
+				std::uint32_t, std::uint64_t>;
+			static constexpr std::size_t width = sizeof(K);
+
+			// Negative values have their order reversed by flipping every
+			// bit; non-negative values move above them by setting the sign.
+			static encoded_type encode(K k) noexcept {
+				constexpr auto sign = encoded_type(1) << (CHAR_BIT * sizeof(K) - 1);
+				encoded_type u;
+				std::memcpy(&u, &k, sizeof(K));
+				return (u & sign) ? ~u : (u | sign);
+			}
+			static constexpr unsigned char digit(encoded_type u, std::size_t i) noexcept {
+				return static_cast<unsigned char>(u >> (CHAR_BIT * i));
+			}
+		};
+
+		template<class B, std::size_t N>
+		requires (N > 0) && (Same<B, unsigned char> || Same<B, std::byte>)
+		struct radix_key<std::array<B, N>> {
+			using encoded_type = std::array<B, N>;
+			static constexpr std::size_t width = N;
+
+			static constexpr const encoded_type& encode(const encoded_type& k) noexcept {
+				return k;
+			}
+			static constexpr unsigned char digit(const encoded_type& k, std::size_t i) noexcept {
+				return static_cast<unsigned char>(k[N - 1 - i]);
+			}
+		};
+
+		template<class K>
+		META_CONCEPT FixedRadixKey = requires(const K& k, std::size_t i) {
+			typename radix_key<K>::encoded_type;
+			radix_key<K>::width;
+			radix_key<K>::digit(radix_key<K>::encode(k), i);
+		};
+
+		template<class K>
+		META_CONCEPT StringRadixKey = ConvertibleTo<const K&, std::string_view>;
+	}
+
+	namespace ext {
+		template<class K>
+		META_CONCEPT RadixKey =
+			detail::FixedRadixKey<K> || detail::StringRadixKey<K>;
+
+		struct __radix_sort_fn : private __niebloid {
+			template<RandomAccessIterator I, Sentinel<I> S, class Proj = identity>
+			requires Permutable<I> && IndirectRegularUnaryInvocable<Proj, I> &&
+				RadixKey<iter_value_t<projected<I, Proj>>>
+			I operator()(I first, S sent, Proj proj = {}) const {
+				auto last = next(first, std::move(sent));
+				const auto n = iter_difference_t<I>(last - first);
+				using K = iter_value_t<projected<I, Proj>>;
+				if constexpr (detail::FixedRadixKey<K>) {
+					lsd_sort<K>(first, n, proj);
+				} else {
+					msd_sort(first, n, proj);
+				}
+				return last;
+			}
+
+			template<RandomAccessRange R, class Proj = identity>
+			requires Permutable<iterator_t<R>> &&
+				IndirectRegularUnaryInvocable<Proj, iterator_t<R>> &&
+				RadixKey<iter_value_t<projected<iterator_t<R>, Proj>>>
+			safe_iterator_t<R> operator()(R&& r, Proj proj = {}) const {
+				return (*this)(begin(r), end(r), __stl2::ref(proj));
+			}
+		private:
+			// Ranges shorter than this are sorted by comparison.
+			static constexpr std::ptrdiff_t lsd_threshold = 256;
+			static constexpr std::ptrdiff_t msd_threshold = 32;
+
+			// Fixed-width keys: one counting pass computes the histograms of
+			// every byte, then each byte that varies between keys gets a
+			// stable scatter pass, least significant first, alternating
+			// between the range and the buffer.
+			template<class K, class I, class Proj>
+			static void lsd_sort(I first, iter_difference_t<I> n, Proj& proj) {
+				using D = iter_difference_t<I>;
+				using V = iter_value_t<I>;
+				using RK = detail::radix_key<K>;
+				auto key = [&](auto&& e) -> typename RK::encoded_type {
+					return RK::encode(__stl2::invoke(proj, static_cast<decltype(e)>(e)));
+				};
+				auto fallback = [&] {
+					__stl2::sort(first, first + n, [&](auto&& a, auto&& b) {
+						return key(static_cast<decltype(a)>(a)) < key(static_cast<decltype(b)>(b));
+					});
+				};
+				if (n < lsd_threshold) {
+					fallback();
+					return;
+				}
+
+				std::vector<std::array<D, 256>> counts(RK::width);
+				for (D i = 0; i < n; ++i) {
+					const auto& k = key(first[i]);
+					for (std::size_t b = 0; b < RK::width; ++b) {
+						++counts[b][RK::digit(k, b)];
+					}
+				}
+
+				std::vector<std::size_t> passes;
+				{
+					const auto& k0 = key(*first);
+					for (std::size_t b = 0; b < RK::width; ++b) {
+						auto& count = counts[b];
+						if (count[RK::digit(k0, b)] == n) continue;
+						passes.push_back(b);
+						D sum = 0;
+						for (auto& c : count) {
+							const D t = c;
+							c = sum;
+							sum += t;
+						}
+					}
+				}
+				if (passes.empty()) return;
+
+				detail::temporary_buffer<V> buf{n};
+				if (buf.size() < n) {
+					fallback();
+					return;
+				}
+
+				auto scatter = [&](auto src, auto&& put, std::size_t b) {
+					auto& offset = counts[b];
+					for (D i = 0; i < n; ++i, ++src) {
+						put(offset[RK::digit(key(*src), b)]++, iter_move(src));
+					}
+				};
+				auto put_range = [&](D pos, auto&& v) {
+					first[pos] = static_cast<decltype(v)>(v);
+				};
+
+				if constexpr (ext::TriviallyCopyable<V>) {
+					// The buffer needs no initialization.
+					V* const tmp = buf.data();
+					auto put_buffer = [&](D pos, auto&& v) {
+						detail::construct(tmp[pos], static_cast<decltype(v)>(v));
+					};
+					bool in_range = true;
+					for (auto b : passes) {
+						if (in_range) {
+							scatter(first, put_buffer, b);
+						} else {
+							scatter(tmp, put_range, b);
+						}
+						in_range = !in_range;
+					}
+					if (!in_range) {
+						__stl2::move(tmp, tmp + n, first);
+					}
+				} else {
+					detail::temporary_vector<V> vec{buf};
+					for (D i = 0; i < n; ++i) {
+						vec.push_back(iter_move(first + i));
+					}
+					auto put_vector = [&](D pos, auto&& v) {
+						vec[pos] = static_cast<decltype(v)>(v);
+					};
+					bool in_range = false;
+					for (auto b : passes) {
+						if (in_range) {
+							scatter(first, put_vector, b);
+						} else {
+							scatter(vec.begin(), put_range, b);
+						}
+						in_range = !in_range;
+					}
+					if (!in_range) {
+						__stl2::move(vec.begin(), vec.end(), first);
+					}
+				}
+			}
+
+			// String keys: partition into 257 buckets on the byte at each
+			// depth (bucket 0 holds keys that end there), alternating between
+			// the range and the buffer at each depth, until buckets are small
+			// enough to sort by comparison.
+			template<class I, class Proj>
+			static void msd_sort(I first, iter_difference_t<I> n, Proj& proj) {
+				using D = iter_difference_t<I>;
+				using V = iter_value_t<I>;
+				auto less_from = [&](std::size_t depth) {
+					return [&proj, depth](auto&& a, auto&& b) {
+						auto&& ka = __stl2::invoke(proj, static_cast<decltype(a)>(a));
+						auto&& kb = __stl2::invoke(proj, static_cast<decltype(b)>(b));
+						return std::string_view(ka).substr(depth) <
+							std::string_view(kb).substr(depth);
+					};
+				};
+				if (n < msd_threshold) {
+					__stl2::sort(first, first + n, less_from(0));
+					return;
+				}
+
+				detail::temporary_buffer<V> buf{n};
+				if (buf.size() < n) {
+					__stl2::sort(first, first + n, less_from(0));
+					return;
+				}
+				detail::temporary_vector<V> vec{buf};
+				for (D i = 0; i < n; ++i) {
+					vec.push_back(iter_move(first + i));
+				}
+				msd_loop(first, vec.begin(), D{0}, n, std::size_t{0}, true, proj, less_from);
+			}
+
+			// Sorts the keys at offsets [lo, hi), which share their first
+			// depth bytes and are in the buffer iff in_buffer, into the range.
+			template<class I, class V, class Proj, class LessFrom>
+			static void msd_loop(I first, V* tmp, iter_difference_t<I> lo,
+				iter_difference_t<I> hi, std::size_t depth, bool in_buffer,
+				Proj& proj, LessFrom& less_from)
+			{
+				using D = iter_difference_t<I>;
+				auto digit = [&](auto&& e) -> std::size_t {
+					auto&& k = __stl2::invoke(proj, static_cast<decltype(e)>(e));
+					const std::string_view sv(k);
+					return depth < sv.size()
+						? 1 + static_cast<unsigned char>(sv[depth]) : 0;
+				};
+				auto to_range = [&](D l, D h) {
+					if (in_buffer) {
+						__stl2::move(tmp + l, tmp + h, first + l);
+					}
+				};
+
+				while (true) {
+					const D n = hi - lo;
+					if (n < msd_threshold) {
+						to_range(lo, hi);
+						__stl2::sort(first + lo, first + hi, less_from(depth));
+						return;
+					}
+
+					std::array<D, 257> count{};
+					if (in_buffer) {
+						for (D i = lo; i < hi; ++i) ++count[digit(tmp[i])];
+					} else {
+						for (D i = lo; i < hi; ++i) ++count[digit(first[i])];
+					}
+
+					if (count[0] == n) {
+						// Every key ends here: they are all equal.
+						to_range(lo, hi);
+						return;
+					}
+					if (count[0] == 0) {
+						std::size_t d = 1;
+						while (count[d] == 0) ++d;
+						if (count[d] == n) {
+							// Every key has the same byte here.
+							++depth;
+							continue;
+						}
+					}
+
+					std::array<D, 258> start;
+					start[0] = lo;
+					for (std::size_t d = 0; d < 257; ++d) {
+						start[d + 1] = start[d] + count[d];
+					}
+					auto offset = start;
+					if (in_buffer) {
+						for (D i = lo; i < hi; ++i) {
+							first[offset[digit(tmp[i])]++] = std::move(tmp[i]);
+						}
+					} else {
+						for (D i = lo; i < hi; ++i) {
+							tmp[offset[digit(first[i])]++] = iter_move(first + i);
+						}
+					}
+					in_buffer = !in_buffer;
+
+					// Keys that end at this depth are equal and done. Recurse
+					// into every other bucket but the largest, which this
+					// loop continues with to bound the depth of recursion.
+					to_range(start[0], start[1]);
+					std::size_t largest = 1;
+					for (std::size_t d = 2; d < 257; ++d) {
+						if (count[d] > count[largest]) largest = d;
+					}
+					for (std::size_t d = 1; d < 257; ++d) {
+						if (d != largest && count[d] > 0) {
+							msd_loop(first, tmp, start[d], start[d + 1], depth + 1,
+								in_buffer, proj, less_from);
+						}
+					}
+					lo = start[largest];
+					hi = start[largest + 1];
+					++depth;
+				}
+			}
+		};
+
+		inline constexpr __radix_sort_fn radix_sort {};
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
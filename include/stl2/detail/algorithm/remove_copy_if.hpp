@@ -12,6 +12,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_REMOVE_COPY_IF_HPP
 #define STL2_DETAIL_ALGORITHM_REMOVE_COPY_IF_HPP
 
+#include <stl2/detail/algorithm/memops.hpp>
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/primitives.hpp>
@@ -19,6 +20,9 @@
 ///////////////////////////////////////////////////////////////////////////
 // remove_copy_if [alg.remove]
 //
+// Contiguous ranges of arithmetic values filtered by an ext::compare_to
+// predicate are compacted several elements at a time.
+//
 STL2_OPEN_NAMESPACE {
 	template<class I, class O>
 	using remove_copy_if_result = __in_out_result<I, O>;
@@ -29,6 +33,15 @@ STL2_OPEN_NAMESPACE {
 		requires IndirectlyCopyable<I, O>
 		constexpr remove_copy_if_result<I, O>
 		operator()(I first, S last, O result, Pred pred, Proj proj = {}) const {
+			if constexpr (SizedSentinel<S, I> && detail::MemFilterable<I, Pred, Proj> &&
+				detail::MemCopyable<I, O>)
+			{
+				if (!detail::is_constant_evaluated()) {
+					const auto n = last - first;
+					result = detail::memfilter_copy_n<false>(first, n, std::move(result), pred);
+					return {first + n, std::move(result)};
+				}
+			}
 			for (; first != last; ++first) {
 				iter_reference_t<I>&& v = *first;
 				if (!__stl2::invoke(pred, __stl2::invoke(proj, v))) {
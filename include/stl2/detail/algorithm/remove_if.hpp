@@ -13,18 +13,27 @@
 #define STL2_DETAIL_ALGORITHM_REMOVE_IF_HPP
 
 #include <stl2/detail/algorithm/find_if.hpp>
+#include <stl2/detail/algorithm/memops.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/primitives.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // remove_if [alg.remove]
 //
+// Contiguous ranges of arithmetic values filtered by an ext::compare_to
+// predicate are compacted several elements at a time.
+//
 STL2_OPEN_NAMESPACE {
 	struct __remove_if_fn : private __niebloid {
 		template<Permutable I, Sentinel<I> S, class Proj = identity,
 			IndirectUnaryPredicate<projected<I, Proj>> Pred>
 		constexpr I
 		operator()(I first, S last, Pred pred, Proj proj = {}) const {
+			if constexpr (SizedSentinel<S, I> && detail::MemFilterable<I, Pred, Proj>) {
+				if (!detail::is_constant_evaluated()) {
+					return detail::memfilter_n<false>(first, last - first, pred);
+				}
+			}
 			first = find_if(std::move(first), last, __stl2::ref(pred),
 				__stl2::ref(proj));
 			if (first != last) {
@@ -23,6 +23,8 @@
 #ifndef STL2_DETAIL_ALGORITHM_SEARCH_HPP
 #define STL2_DETAIL_ALGORITHM_SEARCH_HPP
 
+#include <stl2/detail/algorithm/memops.hpp>
+#include <stl2/detail/algorithm/searchers.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/iterator/counted_iterator.hpp>
 #include <stl2/view/subrange.hpp>
@@ -65,6 +67,20 @@ STL2_OPEN_NAMESPACE {
 					__stl2::ref(pred), __stl2::ref(proj1), __stl2::ref(proj2));
 			}
 		}
+
+		/// Extension: search using a pattern-preprocessing Searcher
+		///
+		template<ForwardIterator I, Sentinel<I> S, ext::Searcher<I, S> Searcher>
+		subrange<I> operator()(I first, S last, const Searcher& searcher) const {
+			return searcher(std::move(first), std::move(last));
+		}
+
+		/// Extension: search a range using a pattern-preprocessing Searcher
+		///
+		template<ForwardRange R, ext::Searcher<iterator_t<R>, sentinel_t<R>> Searcher>
+		safe_subrange_t<R> operator()(R&& r, const Searcher& searcher) const {
+			return searcher(begin(r), end(r));
+		}
 	private:
 		template<ForwardIterator I1, Sentinel<I1> S1,
 			ForwardIterator I2, Sentinel<I2> S2, class Pred = equal_to,
@@ -113,6 +129,15 @@ STL2_OPEN_NAMESPACE {
 				return {first1_, first1_};
 			}
 
+			if constexpr (detail::MemSearchable<I1, I2> &&
+				detail::IsFn<Pred, equal_to> &&
+				detail::IsFn<Proj1, identity> && detail::IsFn<Proj2, identity>)
+			{
+				if (!detail::is_constant_evaluated()) {
+					return detail::memsearch_n(first1_, d1_, std::move(first2), d2);
+				}
+			}
+
 			auto d1 = d1_;
 			auto first1 = ext::uncounted(first1_);
 			for(; d1 >= d2; ++first1, --d1) {
@@ -0,0 +1,359 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_SEARCHERS_HPP
+#define STL2_DETAIL_ALGORITHM_SEARCHERS_HPP
+
+#include <array>
+#include <cstring>
+#include <functional>
+#include <unordered_map>
+#include <stl2/functional.hpp>
+#include <stl2/detail/hash.hpp>
+#include <stl2/detail/algorithm/memops.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/range/primitives.hpp>
+#include <stl2/detail/simd/find.hpp>
+#include <stl2/view/subrange.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Searchers [Extension]
+//
+// Pattern-preprocessing search engines in the spirit of
+// std::boyer_moore_horspool_searcher, for use with the searcher overloads
+// of search and find_end.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		// A Searcher for [I, S) finds the first occurrence of its pattern,
+		// returning it as a subrange or {last, last} if there is none.
+		template<class F, class I, class S = I>
+		META_CONCEPT Searcher =
+			Iterator<I> && Sentinel<S, I> &&
+			Invocable<const F&, I, S> &&
+			Same<invoke_result_t<const F&, I, S>, subrange<I>>;
+	}
+
+	namespace detail {
+		///////////////////////////////////////////////////////////////////////
+		// Crochemore-Perrin two-way string matching: linear time and
+		// constant extra space, requiring a total order on the elements.
+		//
+		struct __two_way {
+			template<class D>
+			struct factorization {
+				D ell;         // x[0, ell] x[ell + 1, m) is a critical factorization
+				D per;         // period of x[ell + 1, m)
+				bool periodic; // x[0, ell] is a suffix of x[ell + 1, ell + 1 + per)
+			};
+
+			template<RandomAccessIterator I, class Comp>
+			static constexpr factorization<iter_difference_t<I>>
+			factorize(I x, iter_difference_t<I> m, Comp& comp) {
+				using D = iter_difference_t<I>;
+				D p = 1, q = 1;
+				D i = maximal_suffix(x, m, comp, false, p);
+				D j = maximal_suffix(x, m, comp, true, q);
+				factorization<D> f = i > j
+					? factorization<D>{i, p, false}
+					: factorization<D>{j, q, false};
+				if (f.per + f.ell + 1 <= m) {
+					f.periodic = true;
+					for (D k = 0; k <= f.ell; ++k) {
+						if (!equivalent(comp, x[k], x[k + f.per])) {
+							f.periodic = false;
+							break;
+						}
+					}
+				}
+				return f;
+			}
+
+			// Returns the offset of the first occurrence of x[0, m) in
+			// y[0, n), or n if there is none. Pre: 0 < m
+			template<RandomAccessIterator I1, RandomAccessIterator I2, class Comp>
+			static constexpr iter_difference_t<I1>
+			search(I1 y, iter_difference_t<I1> n, I2 x, iter_difference_t<I2> m_,
+				const factorization<iter_difference_t<I2>>& f, Comp& comp)
+			{
+				using D = iter_difference_t<I1>;
+				STL2_EXPECT(m_ > 0);
+				const D m = m_;
+				const D ell = f.ell;
+				if (n < m) return n;
+
+				if (f.periodic) {
+					const D per = f.per;
+					D memory = -1;
+					for (D j = 0; j <= n - m;) {
+						D i = (ell > memory ? ell : memory) + 1;
+						while (i < m && equivalent(comp, x[i], y[i + j])) ++i;
+						if (i >= m) {
+							i = ell;
+							while (i > memory && equivalent(comp, x[i], y[i + j])) --i;
+							if (i <= memory) return j;
+							j += per;
+							memory = m - per - 1;
+						} else {
+							j += i - ell;
+							memory = -1;
+						}
+					}
+				} else {
+					const D per = (ell + 1 > m - ell - 1 ? ell + 1 : m - ell - 1) + 1;
+					for (D j = 0; j <= n - m;) {
+						D i = ell + 1;
+						while (i < m && equivalent(comp, x[i], y[i + j])) ++i;
+						if (i >= m) {
+							i = ell;
+							while (i >= 0 && equivalent(comp, x[i], y[i + j])) --i;
+							if (i < 0) return j;
+							j += per;
+						} else {
+							j += i - ell;
+						}
+					}
+				}
+				return n;
+			}
+
+		private:
+			template<class Comp, class T, class U>
+			static constexpr bool equivalent(Comp& comp, T&& t, U&& u) {
+				return !__stl2::invoke(comp, t, u) && !__stl2::invoke(comp, u, t);
+			}
+
+			// Returns the start of the maximal suffix of x[0, m) under the
+			// order comp (or its reverse), minus one; period receives the
+			// period of that suffix.
+			template<RandomAccessIterator I, class Comp>
+			static constexpr iter_difference_t<I>
+			maximal_suffix(I x, iter_difference_t<I> m, Comp& comp, bool reversed,
+				iter_difference_t<I>& period)
+			{
+				using D = iter_difference_t<I>;
+				D ms = -1, j = 0, k = 1;
+				period = 1;
+				while (j + k < m) {
+					auto&& a = x[j + k];
+					auto&& b = x[ms + k];
+					if (reversed ? __stl2::invoke(comp, b, a) : __stl2::invoke(comp, a, b)) {
+						j += k;
+						k = 1;
+						period = j - ms;
+					} else if (reversed ? __stl2::invoke(comp, a, b) : __stl2::invoke(comp, b, a)) {
+						ms = j;
+						j = ms + 1;
+						k = period = 1;
+					} else if (k != period) {
+						++k;
+					} else {
+						j += period;
+						k = 1;
+					}
+				}
+				return ms;
+			}
+		};
+
+		///////////////////////////////////////////////////////////////////////
+		// memsearch_n: search over contiguous ranges of the same integer type,
+		// where element equality is equality of object representations.
+		//
+		template<class I1, class I2>
+		META_CONCEPT MemSearchable =
+			MemFindable<I1, iter_value_t<I2>> && MemIterator<I2> &&
+			Same<iter_value_t<I1>, iter_value_t<I2>>;
+
+		struct __memsearch_n_fn {
+			// Needles at least this long use the two-way engine, whose
+			// worst case is linear; shorter needles are located by
+			// scanning for their first element and comparing the rest.
+			static constexpr std::ptrdiff_t two_way_threshold = 32;
+
+			template<class I1, class I2>
+			requires MemSearchable<I1, I2>
+			subrange<I1> operator()(I1 first1, iter_difference_t<I1> n,
+				I2 first2, iter_difference_t<I2> m) const
+			{
+				using V = iter_value_t<I1>;
+				STL2_EXPECT(n >= 0);
+				STL2_EXPECT(m >= 0);
+				if (m == 0) return {first1, first1};
+				if (n < m) {
+					first1 += n;
+					return {first1, first1};
+				}
+
+				const V* const y = std::addressof(*first1);
+				const V* const x = std::addressof(*first2);
+				iter_difference_t<I1> pos = n;
+				if (m >= two_way_threshold) {
+					less comp;
+					auto f = __two_way::factorize(x, std::ptrdiff_t(m), comp);
+					pos = __two_way::search(y, std::ptrdiff_t(n), x, std::ptrdiff_t(m), f, comp);
+				} else {
+					const V* const limit = y + (n - m) + 1;
+					const auto rest = static_cast<std::size_t>(m - 1) * sizeof(V);
+					for (const V* p = y; (p = simd::find_eq(p, limit, x[0])) != limit; ++p) {
+						if (std::memcmp(p + 1, x + 1, rest) == 0) {
+							pos = p - y;
+							break;
+						}
+					}
+				}
+				if (pos == n) {
+					first1 += n;
+					return {first1, first1};
+				}
+				first1 += pos;
+				return {first1, first1 + m};
+			}
+		};
+
+		inline constexpr __memsearch_n_fn memsearch_n {};
+	}
+
+	namespace ext {
+		///////////////////////////////////////////////////////////////////////
+		// boyer_moore_horspool_searcher [Extension]
+		// Sublinear on average for long patterns over large alphabets. Uses a
+		// 256-entry shift table for byte-sized integers compared with
+		// equal_to, and a hash table keyed with Hash and Pred otherwise.
+		//
+		template<RandomAccessIterator I,
+			class Hash = std::hash<iter_value_t<I>>, class Pred = equal_to>
+		requires IndirectRelation<Pred, I> &&
+			CopyConstructible<Hash> &&
+			RegularInvocable<const Hash&, const iter_value_t<I>&> &&
+			ConvertibleTo<invoke_result_t<const Hash&, const iter_value_t<I>&>, std::size_t>
+		class boyer_moore_horspool_searcher {
+			using D = iter_difference_t<I>;
+			using V = iter_value_t<I>;
+			static constexpr bool byte_table =
+				sizeof(V) == 1 && Integral<V> && detail::IsFn<Pred, equal_to>;
+			using table_t = meta::if_c<byte_table,
+				std::array<D, 256>, std::unordered_map<V, D, Hash, Pred>>;
+
+			I first_;
+			D m_;
+			Pred pred_;
+			table_t table_;
+
+			D shift(const V& v) const {
+				if constexpr (byte_table) {
+					return table_[static_cast<unsigned char>(v)];
+				} else {
+					auto i = table_.find(v);
+					return i == table_.end() ? m_ : i->second;
+				}
+			}
+		public:
+			boyer_moore_horspool_searcher(I first, I last, Hash hf = {}, Pred pred = {})
+			: first_(first), m_(last - first), pred_(pred)
+			, table_(make_table(first, m_, std::move(hf), std::move(pred)))
+			{}
+
+			template<RandomAccessIterator I2, Sentinel<I2> S2>
+			requires Same<iter_value_t<I2>, V> && IndirectRelation<Pred, I2, I>
+			subrange<I2> operator()(I2 first, S2 last) const {
+				auto end = next(first, std::move(last));
+				if (m_ == 0) return {first, first};
+				using D2 = iter_difference_t<I2>;
+				const D2 n = end - first;
+				const D2 m = m_;
+				auto pred = pred_;
+				for (D2 pos = 0; n - pos >= m;) {
+					for (D2 j = m - 1; __stl2::invoke(pred, first[pos + j], first_[j]); --j) {
+						if (j == 0) {
+							first += pos;
+							return {first, first + m};
+						}
+					}
+					pos += shift(first[pos + m - 1]);
+				}
+				return {end, end};
+			}
+
+		private:
+			static table_t make_table(I x, D m, Hash hf, Pred pred) {
+				if constexpr (byte_table) {
+					table_t table;
+					table.fill(m);
+					for (D i = 0; i < m - 1; ++i) {
+						table[static_cast<unsigned char>(x[i])] = m - 1 - i;
+					}
+					return table;
+				} else {
+					table_t table(m > 1 ? m - 1 : 1, std::move(hf), std::move(pred));
+					for (D i = 0; i < m - 1; ++i) {
+						table.insert_or_assign(x[i], m - 1 - i);
+					}
+					return table;
+				}
+			}
+		};
+
+		template<RandomAccessIterator I>
+		boyer_moore_horspool_searcher(I, I) -> boyer_moore_horspool_searcher<I>;
+		template<RandomAccessIterator I, class Hash>
+		boyer_moore_horspool_searcher(I, I, Hash) ->
+			boyer_moore_horspool_searcher<I, Hash>;
+		template<RandomAccessIterator I, class Hash, class Pred>
+		boyer_moore_horspool_searcher(I, I, Hash, Pred) ->
+			boyer_moore_horspool_searcher<I, Hash, Pred>;
+
+		///////////////////////////////////////////////////////////////////////
+		// two_way_searcher [Extension]
+		// Crochemore-Perrin two-way matching: linear worst case with constant
+		// extra space, for long patterns whose elements are totally ordered
+		// by Comp. Elements are equal when equivalent under Comp.
+		//
+		template<RandomAccessIterator I, class Comp = less>
+		requires IndirectStrictWeakOrder<Comp, I>
+		class two_way_searcher {
+			using D = iter_difference_t<I>;
+
+			I first_;
+			D m_;
+			Comp comp_;
+			detail::__two_way::factorization<D> f_;
+		public:
+			two_way_searcher(I first, I last, Comp comp = {})
+			: first_(first), m_(last - first), comp_(std::move(comp)), f_{}
+			{
+				if (m_ > 0) {
+					f_ = detail::__two_way::factorize(first_, m_, comp_);
+				}
+			}
+
+			template<RandomAccessIterator I2, Sentinel<I2> S2>
+			requires IndirectStrictWeakOrder<Comp, I2, I>
+			subrange<I2> operator()(I2 first, S2 last) const {
+				auto end = next(first, std::move(last));
+				if (m_ == 0) return {first, first};
+				const auto n = iter_difference_t<I2>(end - first);
+				auto comp = comp_;
+				const auto pos = detail::__two_way::search(first, n, first_, m_, f_, comp);
+				if (pos == n) return {end, end};
+				first += pos;
+				return {first, first + m_};
+			}
+		};
+
+		template<RandomAccessIterator I>
+		two_way_searcher(I, I) -> two_way_searcher<I>;
+		template<RandomAccessIterator I, class Comp>
+		two_way_searcher(I, I, Comp) -> two_way_searcher<I, Comp>;
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -12,6 +12,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_SET_INTERSECTION_HPP
 #define STL2_DETAIL_ALGORITHM_SET_INTERSECTION_HPP
 
+#include <stl2/detail/algorithm/memops.hpp>
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/primitives.hpp>
@@ -19,6 +20,10 @@
 ///////////////////////////////////////////////////////////////////////////
 // set_intersection [set.intersection]
 //
+// Contiguous ranges of integers sorted by < are merged by galloping when
+// one is much longer than the other, and several elements at a time when
+// they are of similar length.
+//
 STL2_OPEN_NAMESPACE {
 	template<class I1, class I2, class O>
 	using set_intersection_result = __in_in_out_result<I1, I2, O>;
@@ -32,6 +37,14 @@ STL2_OPEN_NAMESPACE {
 		operator()(I1 first1, S1 last1, I2 first2, S2 last2, O result,
 			Comp comp = {}, Proj1 proj1 = {}, Proj2 proj2 = {}) const
 		{
+			if constexpr (SizedSentinel<S1, I1> && SizedSentinel<S2, I2> &&
+				detail::MemSetOperable<I1, I2, Comp, Proj1, Proj2>)
+			{
+				if (!detail::is_constant_evaluated()) {
+					return detail::memintersect_n(first1, last1 - first1,
+						first2, last2 - first2, std::move(result));
+				}
+			}
 			while (bool(first1 != last1) && bool(first2 != last2)) {
 				iter_reference_t<I1>&& v1 = *first1;
 				iter_reference_t<I2>&& v2 = *first2;
@@ -10,17 +10,43 @@
 //
 // Project home: https://github.com/caseycarter/cmcstl2
 //
+//===----------------------------------------------------------------------===//
+//
+// The random access engine is derived from pdqsort:
+//
+//  Copyright Orson Peters 2021
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// See https://github.com/orlp/pdqsort for the full zlib license text.
+//
+//===----------------------------------------------------------------------===//
+//
 #ifndef STL2_DETAIL_ALGORITHM_SORT_HPP
 #define STL2_DETAIL_ALGORITHM_SORT_HPP
 
+#include <cstddef>
+#include <utility>
+#include <stl2/detail/algorithm/block_partition.hpp>
 #include <stl2/detail/algorithm/forward_sort.hpp>
+#include <stl2/detail/algorithm/make_heap.hpp>
+#include <stl2/detail/algorithm/memops.hpp>
 #include <stl2/detail/algorithm/random_access_sort.hpp>
+#include <stl2/detail/algorithm/sort_heap.hpp>
 #include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/execution.hpp>
 #include <stl2/detail/range/primitives.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // sort [sort]
 //
+// Random access ranges are sorted with pattern-defeating quicksort: ninther
+// pivots for large partitions, early exit for already-partitioned inputs
+// that insertion sort can finish cheaply, deterministic shuffles to break
+// up patterns that produce unbalanced partitions, and heapsort once too
+// many partitions have been unbalanced. Comparisons of arithmetic values
+// with less or greater use branchless block partitioning. The parallel
+// overload runs the partitions of the top levels as separate tasks.
+//
 STL2_OPEN_NAMESPACE {
 	struct __sort_fn : private __niebloid {
 		/// Extension: sort using forward iterators
@@ -33,9 +59,7 @@ STL2_OPEN_NAMESPACE {
 			if constexpr (RandomAccessIterator<I>) {
 				if (first == sent) return first;
 				auto last = next(first, std::move(sent));
-				auto n = distance(first, last);
-				introsort_loop(first, last, log2(n) * 2, comp, proj);
-				final_insertion_sort(first, last, comp, proj);
+				pdqsort(first, last, comp, proj);
 				return last;
 			} else {
 				auto n = distance(first, std::move(sent));
@@ -51,83 +75,383 @@ STL2_OPEN_NAMESPACE {
 		operator()(R&& r, Comp comp = {}, Proj proj = {}) const {
 			return (*this)(begin(r), end(r), std::move(comp), std::move(proj));
 		}
+
+		/// Extension: parallel sort
+		///
+		template<RandomAccessIterator I, Sentinel<I> S, class Comp = less,
+			class Proj = identity>
+		requires Sortable<I, Comp, Proj>
+		I operator()(const ext::parallel_policy& policy, I first, S sent,
+			Comp comp = {}, Proj proj = {}) const
+		{
+			auto last = next(first, std::move(sent));
+			const auto n = iter_difference_t<I>(last - first);
+			const auto cutoff = static_cast<iter_difference_t<I>>(
+				detail::parallel_chunk(policy, static_cast<std::ptrdiff_t>(n)));
+			if (n <= cutoff) {
+				if (n > 0) pdqsort(first, last, comp, proj);
+				return last;
+			}
+			detail::task_group tasks;
+			parallel_loop(tasks, first, last, comp, proj, log2(n), cutoff, true);
+			tasks.wait();
+			return last;
+		}
+
+		template<RandomAccessRange R, class Comp = less, class Proj = identity>
+		requires Sortable<iterator_t<R>, Comp, Proj>
+		safe_iterator_t<R>
+		operator()(const ext::parallel_policy& policy, R&& r, Comp comp = {},
+			Proj proj = {}) const
+		{
+			return (*this)(policy, begin(r), end(r), __stl2::ref(comp),
+				__stl2::ref(proj));
+		}
 	private:
-		static constexpr std::ptrdiff_t introsort_threshold = 16;
+		// Partitions smaller than this are insertion sorted.
+		static constexpr std::ptrdiff_t insertion_sort_threshold = 24;
+		// Partitions larger than this use Tukey's ninther for the pivot.
+		static constexpr std::ptrdiff_t ninther_threshold = 128;
+		// An already-partitioned input is abandoned to quicksort once
+		// partial_insertion_sort has moved this many elements.
+		static constexpr std::ptrdiff_t partial_insertion_sort_limit = 8;
 
 		template<RandomAccessIterator I, class Comp, class Proj>
 		requires Sortable<I, Comp, Proj>
-		static constexpr I
+		static constexpr void
+		sort2(I a, I b, Comp& comp, Proj& proj) {
+			if (__stl2::invoke(comp, __stl2::invoke(proj, *b), __stl2::invoke(proj, *a))) {
+				iter_swap(a, b);
+			}
+		}
+
+		template<RandomAccessIterator I, class Comp, class Proj>
+		requires Sortable<I, Comp, Proj>
+		static constexpr void
+		sort3(I a, I b, I c, Comp& comp, Proj& proj) {
+			sort2(a, b, comp, proj);
+			sort2(b, c, comp, proj);
+			sort2(a, b, comp, proj);
+		}
+
+		// Moves the pivot for [first, last) to *first: the median of three,
+		// or the pseudomedian of nine for large ranges. Afterwards there is
+		// an element no less than the pivot in [first + 1, last), and unless
+		// first is the leftmost position an element no greater than it.
+		template<RandomAccessIterator I, class Comp, class Proj>
+		requires Sortable<I, Comp, Proj>
+		static constexpr void
 		choose_pivot(I first, I last, Comp& comp, Proj& proj) {
-			STL2_EXPECT(first != last);
-			I mid = first + iter_difference_t<I>(last - first) / 2;
-			--last;
-			// Find the median:
-			return [&](auto&& a, auto&& b, auto&& c) {
-				return __stl2::invoke(comp, a, b)
-					? (__stl2::invoke(comp, b, c) ? mid   : (__stl2::invoke(comp, a, c) ? last : first))
-					: (__stl2::invoke(comp, a, c) ? first : (__stl2::invoke(comp, b, c) ? last : mid  ));
-			}(__stl2::invoke(proj, *first), __stl2::invoke(proj, *mid), __stl2::invoke(proj, *last));
+			const auto n = iter_difference_t<I>(last - first);
+			const auto half = n / 2;
+			if (n > ninther_threshold) {
+				sort3(first, first + half, last - 1, comp, proj);
+				sort3(first + 1, first + (half - 1), last - 2, comp, proj);
+				sort3(first + 2, first + (half + 1), last - 3, comp, proj);
+				sort3(first + (half - 1), first + half, first + (half + 1), comp, proj);
+				iter_swap(first, first + half);
+			} else {
+				sort3(first + half, first, last - 1, comp, proj);
+			}
+		}
+
+		// Insertion sort that gives up after moving partial_insertion_sort_limit
+		// elements. Returns true iff [first, last) is sorted.
+		template<RandomAccessIterator I, class Comp, class Proj>
+		requires Sortable<I, Comp, Proj>
+		static constexpr bool
+		partial_insertion_sort(I first, I last, Comp& comp, Proj& proj) {
+			if (first == last) return true;
+
+			auto pred = [&](auto&& lhs, auto&& rhs) -> bool {
+				return __stl2::invoke(comp,
+					__stl2::invoke(proj, static_cast<decltype(lhs)>(lhs)),
+					__stl2::invoke(proj, static_cast<decltype(rhs)>(rhs)));
+			};
+
+			iter_difference_t<I> moved = 0;
+			for (I cur = first + 1; cur != last; ++cur) {
+				I sift = cur;
+				I sift_1 = cur - 1;
+				if (pred(*sift, *sift_1)) {
+					iter_value_t<I> tmp = iter_move(sift);
+					do {
+						*sift = iter_move(sift_1);
+						--sift;
+					} while (sift != first && pred(tmp, *--sift_1));
+					*sift = std::move(tmp);
+					moved += cur - sift;
+				}
+				if (moved > partial_insertion_sort_limit) return false;
+			}
+			return true;
 		}
 
+		// Partitions [first, last) around the pivot *first, placing elements
+		// equal to the pivot on the left. Used when the pivot equals the
+		// element before first: the left partition is then all equal and
+		// needs no further sorting. Returns the final position of the pivot.
 		template<RandomAccessIterator I, class Comp, class Proj>
 		requires Sortable<I, Comp, Proj>
 		static constexpr I
-		unguarded_partition(I first, I last, Comp& comp, Proj& proj) {
-			I pivot_pnt = choose_pivot(first, last, comp, proj);
+		partition_left(I first, I last, Comp& comp, Proj& proj) {
+			auto pred = [&](auto&& lhs, auto&& rhs) -> bool {
+				return __stl2::invoke(comp,
+					__stl2::invoke(proj, static_cast<decltype(lhs)>(lhs)),
+					__stl2::invoke(proj, static_cast<decltype(rhs)>(rhs)));
+			};
+
+			const I begin = first;
+			const I end = last;
+			iter_value_t<I> pivot = iter_move(first);
 
-			// Do the partition:
+			while (pred(pivot, *--last)) {}
+			if (last + 1 == end) {
+				while (first < last && !pred(pivot, *++first)) {}
+			} else {
+				while (!pred(pivot, *++first)) {}
+			}
+
+			while (first < last) {
+				iter_swap(first, last);
+				while (pred(pivot, *--last)) {}
+				while (!pred(pivot, *++first)) {}
+			}
+
+			*begin = iter_move(last);
+			*last = std::move(pivot);
+			return last;
+		}
+
+		// Partitions [first, last) around the pivot *first, placing elements
+		// equal to the pivot on the right. Returns the final position of the
+		// pivot, and whether the range was already partitioned.
+		template<RandomAccessIterator I, class Comp, class Proj>
+		requires Sortable<I, Comp, Proj>
+		static constexpr std::pair<I, bool>
+		partition_right(I first, I last, Comp& comp, Proj& proj) {
+			auto pred = [&](auto&& lhs, auto&& rhs) -> bool {
+				return __stl2::invoke(comp,
+					__stl2::invoke(proj, static_cast<decltype(lhs)>(lhs)),
+					__stl2::invoke(proj, static_cast<decltype(rhs)>(rhs)));
+			};
+
+			const I begin = first;
+			iter_value_t<I> pivot = iter_move(first);
+
+			// choose_pivot guarantees an element >= pivot to stop this scan...
+			while (pred(*++first, pivot)) {}
+			// ...but not an element < pivot unless something preceded first.
+			if (first - 1 == begin) {
+				while (first < last && !pred(*--last, pivot)) {}
+			} else {
+				while (!pred(*--last, pivot)) {}
+			}
+
+			const bool already_partitioned = !(first < last);
+			while (first < last) {
+				iter_swap(first, last);
+				while (pred(*++first, pivot)) {}
+				while (!pred(*--last, pivot)) {}
+			}
+
+			I pivot_pos = first - 1;
+			*begin = iter_move(pivot_pos);
+			*pivot_pos = std::move(pivot);
+			return {pivot_pos, already_partitioned};
+		}
+
+		// As partition_right, but partitions the elements between the
+		// guards with detail::block_partition, which does not branch on the
+		// comparisons.
+		template<RandomAccessIterator I, class Comp, class Proj>
+		requires Sortable<I, Comp, Proj>
+		static std::pair<I, bool>
+		partition_right_branchless(I first, I last, Comp& comp, Proj& proj) {
+			auto pred = [&](auto&& lhs, auto&& rhs) -> bool {
+				return __stl2::invoke(comp,
+					__stl2::invoke(proj, static_cast<decltype(lhs)>(lhs)),
+					__stl2::invoke(proj, static_cast<decltype(rhs)>(rhs)));
+			};
+
+			const I begin = first;
+			iter_value_t<I> pivot = iter_move(first);
+
+			while (pred(*++first, pivot)) {}
+			if (first - 1 == begin) {
+				while (first < last && !pred(*--last, pivot)) {}
+			} else {
+				while (!pred(*--last, pivot)) {}
+			}
+
+			const bool already_partitioned = !(first < last);
+			if (!already_partitioned) {
+				iter_swap(first, last);
+				++first;
+
+				auto less_pivot = [&](auto&& x) -> bool {
+					return pred(static_cast<decltype(x)>(x), pivot);
+				};
+				first = detail::block_partition(first, last, less_pivot);
+			}
+
+			I pivot_pos = first - 1;
+			*begin = iter_move(pivot_pos);
+			*pivot_pos = std::move(pivot);
+			return {pivot_pos, already_partitioned};
+		}
+
+		// Sorts [first, last). If !leftmost, *(first - 1) is no greater than
+		// any element of the range. bad_allowed is the number of unbalanced
+		// partitions tolerated before falling back to heapsort.
+		template<bool Branchless, RandomAccessIterator I, class Comp, class Proj>
+		requires Sortable<I, Comp, Proj>
+		static constexpr void
+		pdqsort_loop(I first, I last, Comp& comp, Proj& proj,
+			iter_difference_t<I> bad_allowed, bool leftmost)
+		{
 			while (true) {
-				auto&& v = *pivot_pnt;
-				auto&& pivot = __stl2::invoke(proj, std::forward<decltype(v)>(v));
-				while (__stl2::invoke(comp, __stl2::invoke(proj, *first), pivot)) {
-					++first;
+				const auto n = iter_difference_t<I>(last - first);
+				if (n < insertion_sort_threshold) {
+					if (leftmost) {
+						detail::rsort::insertion_sort(first, last, comp, proj);
+					} else {
+						unguarded_insertion_sort(first, last, comp, proj);
+					}
+					return;
 				}
-				while (__stl2::invoke(comp, pivot, __stl2::invoke(proj, *--last))) {
-					; // do nothing
+
+				choose_pivot(first, last, comp, proj);
+
+				// If the pivot equals the element preceding the range, no
+				// element is less than it: put the elements equal to it on
+				// the left, where they are already in their final positions.
+				if (!leftmost && !__stl2::invoke(comp,
+						__stl2::invoke(proj, *(first - 1)), __stl2::invoke(proj, *first))) {
+					first = partition_left(first, last, comp, proj) + 1;
+					continue;
 				}
-				if (!(first < last)) {
-					return first;
+
+				auto [pivot_pos, already_partitioned] = [&] {
+					if constexpr (Branchless) {
+						return partition_right_branchless(first, last, comp, proj);
+					} else {
+						return partition_right(first, last, comp, proj);
+					}
+				}();
+
+				const auto l_size = iter_difference_t<I>(pivot_pos - first);
+				const auto r_size = iter_difference_t<I>(last - (pivot_pos + 1));
+				if (l_size < n / 8 || r_size < n / 8) {
+					if (--bad_allowed == 0) {
+						make_heap(first, last, __stl2::ref(comp), __stl2::ref(proj));
+						sort_heap(first, last, __stl2::ref(comp), __stl2::ref(proj));
+						return;
+					}
+					break_patterns(first, pivot_pos, l_size);
+					break_patterns(pivot_pos + 1, last, r_size);
+				} else if (already_partitioned &&
+					partial_insertion_sort(first, pivot_pos, comp, proj) &&
+					partial_insertion_sort(pivot_pos + 1, last, comp, proj)) {
+					return;
 				}
-				iter_swap(first, last);
-				pivot_pnt = pivot_pnt == first ? last : (pivot_pnt == last ? first : pivot_pnt);
-				++first;
+
+				pdqsort_loop<Branchless>(first, pivot_pos, comp, proj, bad_allowed, leftmost);
+				first = pivot_pos + 1;
+				leftmost = false;
 			}
 		}
 
 		template<RandomAccessIterator I, class Comp, class Proj>
 		requires Sortable<I, Comp, Proj>
 		static constexpr void
-		introsort_loop(I first, I last, iter_difference_t<I> depth_limit, Comp& comp, Proj& proj)
-		{
-			while (distance(first, last) > introsort_threshold) {
-				if (depth_limit == 0) {
-					partial_sort(first, last, last, __stl2::ref(comp), __stl2::ref(proj));
+		pdqsort(I first, I last, Comp& comp, Proj& proj, bool leftmost = true) {
+			const auto bad_allowed = log2(iter_difference_t<I>(last - first));
+			if constexpr (detail::BranchlessSortable<I, Comp, Proj>) {
+				if (!detail::is_constant_evaluated()) {
+					pdqsort_loop<true>(first, last, comp, proj, bad_allowed, leftmost);
 					return;
 				}
-				I cut = unguarded_partition(first, last, comp, proj);
-				introsort_loop(cut, last, --depth_limit, comp, proj);
-				last = cut;
 			}
+			pdqsort_loop<false>(first, last, comp, proj, bad_allowed, leftmost);
 		}
 
-		template<BidirectionalIterator I, class Comp, class Proj>
+		// The top levels of pdqsort_loop: each partition step hands its left
+		// part to another thread, until parts are shorter than cutoff.
+		template<RandomAccessIterator I, class Comp, class Proj>
 		requires Sortable<I, Comp, Proj>
+		static void
+		parallel_loop(detail::task_group& tasks, I first, I last, Comp& comp,
+			Proj& proj, iter_difference_t<I> bad_allowed, iter_difference_t<I> cutoff,
+			bool leftmost)
+		{
+			while (last - first > cutoff && !tasks.cancelled()) {
+				const auto n = iter_difference_t<I>(last - first);
+				choose_pivot(first, last, comp, proj);
+
+				// As in pdqsort_loop: the elements equal to a pivot that
+				// equals the element preceding the range are already in
+				// their final positions.
+				if (!leftmost && !__stl2::invoke(comp,
+						__stl2::invoke(proj, *(first - 1)), __stl2::invoke(proj, *first))) {
+					first = partition_left(first, last, comp, proj) + 1;
+					continue;
+				}
+
+				I pivot_pos = [&] {
+					if constexpr (detail::BranchlessSortable<I, Comp, Proj>) {
+						return partition_right_branchless(first, last, comp, proj).first;
+					} else {
+						return partition_right(first, last, comp, proj).first;
+					}
+				}();
+
+				const auto l_size = iter_difference_t<I>(pivot_pos - first);
+				const auto r_size = iter_difference_t<I>(last - (pivot_pos + 1));
+				if (l_size < n / 8 || r_size < n / 8) {
+					if (--bad_allowed == 0) break;
+					break_patterns(first, pivot_pos, l_size);
+					break_patterns(pivot_pos + 1, last, r_size);
+				}
+
+				tasks.run([&tasks, &comp, &proj, first, pivot_pos, bad_allowed, cutoff,
+					leftmost]
+				{
+					parallel_loop(tasks, first, pivot_pos, comp, proj, bad_allowed, cutoff,
+						leftmost);
+				});
+				first = pivot_pos + 1;
+				leftmost = false;
+			}
+			if (last - first > 1 && !tasks.cancelled()) {
+				pdqsort(first, last, comp, proj, leftmost);
+			}
+		}
+
+		// Swaps elements from the ends of an unbalanced partition into its
+		// interior so that the next choice of pivot sees different values.
+		template<RandomAccessIterator I>
+		requires Permutable<I>
 		static constexpr void
-		unguarded_insertion_sort(I first, I last, Comp& comp, Proj& proj) {
-			for (I i = first; i != last; ++i) {
-				detail::rsort::unguarded_linear_insert(i, iter_move(i), comp, proj);
+		break_patterns(I first, I last, iter_difference_t<I> n) {
+			if (n < insertion_sort_threshold) return;
+			const auto q = n / 4;
+			iter_swap(first, first + q);
+			iter_swap(last - 1, last - q);
+			if (n > ninther_threshold) {
+				iter_swap(first + 1, first + (q + 1));
+				iter_swap(first + 2, first + (q + 2));
+				iter_swap(last - 2, last - (q + 1));
+				iter_swap(last - 3, last - (q + 2));
 			}
 		}
 
-		template<RandomAccessIterator I, class Comp, class Proj>
+		template<BidirectionalIterator I, class Comp, class Proj>
 		requires Sortable<I, Comp, Proj>
 		static constexpr void
-		final_insertion_sort(I first, I last, Comp &comp, Proj &proj) {
-			if (distance(first, last) > introsort_threshold) {
-				detail::rsort::insertion_sort(first, first + introsort_threshold, comp, proj);
-				unguarded_insertion_sort(first + introsort_threshold, last, comp, proj);
-			} else {
-				detail::rsort::insertion_sort(first, last, comp, proj);
+		unguarded_insertion_sort(I first, I last, Comp& comp, Proj& proj) {
+			for (I i = first; i != last; ++i) {
+				detail::rsort::unguarded_linear_insert(i, iter_move(i), comp, proj);
 			}
 		}
 
@@ -35,14 +35,16 @@
 #ifndef STL2_DETAIL_ALGORITHM_STABLE_SORT_HPP
 #define STL2_DETAIL_ALGORITHM_STABLE_SORT_HPP
 
+#include <limits>
+#include <type_traits>
 #include <stl2/detail/algorithm/forward_sort.hpp>
 #include <stl2/detail/algorithm/inplace_merge.hpp>
-#include <stl2/detail/algorithm/merge.hpp>
-#include <stl2/detail/algorithm/min.hpp>
+#include <stl2/detail/algorithm/lower_bound.hpp>
 #include <stl2/detail/algorithm/random_access_sort.hpp>
+#include <stl2/detail/algorithm/reverse.hpp>
+#include <stl2/detail/algorithm/upper_bound.hpp>
 #include <stl2/detail/concepts/callable.hpp>
-#include <stl2/detail/iterator/insert_iterators.hpp>
-#include <stl2/detail/iterator/move_iterator.hpp>
+#include <stl2/detail/execution.hpp>
 #include <stl2/detail/range/primitives.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -56,13 +58,7 @@ STL2_OPEN_NAMESPACE {
 		I operator()(I first, S&& last_, Comp comp = {}, Proj proj = {}) const {
 			if constexpr (RandomAccessIterator<I>) {
 				auto last = next(first, std::forward<S>(last_));
-				auto len = iter_difference_t<I>(last - first);
-				auto buf = len > 256 ? buf_t<I>{len} : buf_t<I>{};
-				if (!buf.size()) {
-					inplace_stable_sort(first, last, comp, proj);
-				} else {
-					stable_sort_adaptive(first, last, buf, comp, proj);
-				}
+				random_access_stable_sort(first, last, comp, proj);
 				return last;
 			} else {
 				auto n = distance(first, std::forward<S>(last_));
@@ -83,102 +79,188 @@ STL2_OPEN_NAMESPACE {
 					__stl2::ref(proj));
 			}
 		}
+
+		/// Extension: parallel stable sort
+		///
+		template<RandomAccessIterator I, Sentinel<I> S, class Comp = less,
+			class Proj = identity>
+		requires Sortable<I, Comp, Proj>
+		I operator()(const ext::parallel_policy& policy, I first, S last_,
+			Comp comp = {}, Proj proj = {}) const
+		{
+			auto last = next(first, std::move(last_));
+			const auto cutoff = static_cast<iter_difference_t<I>>(
+				detail::parallel_chunk(policy, static_cast<std::ptrdiff_t>(last - first)));
+			parallel_stable_sort(first, last, cutoff, comp, proj);
+			return last;
+		}
+
+		template<RandomAccessRange R, class Comp = less, class Proj = identity>
+		requires Sortable<iterator_t<R>, Comp, Proj>
+		safe_iterator_t<R> operator()(const ext::parallel_policy& policy, R&& r,
+			Comp comp = {}, Proj proj = {}) const
+		{
+			return (*this)(policy, begin(r), end(r), __stl2::ref(comp),
+				__stl2::ref(proj));
+		}
 	private:
 		template<class I>
 		using buf_t = detail::temporary_buffer<iter_value_t<I>>;
 
-		static constexpr int merge_sort_chunk_size = 7;
-
+		// Powersort (Munro and Wild, 2018): finds the natural runs of the
+		// input, extending short ones to min_run by insertion sort, and
+		// merges them in the order given by the "power" of the boundaries
+		// between neighbouring runs. That order is close to optimal for
+		// the run lengths, so input that is sorted or made of a few
+		// sorted batches takes O(n) time. Merges use buf when it is big
+		// enough for the smaller run and rotations when it is not.
 		template<RandomAccessIterator I, class C, class P>
 		requires Sortable<I, C, P>
-		static void inplace_stable_sort(I first, I last, C &pred, P &proj) {
-			if (last - first < 15) {
-				detail::rsort::insertion_sort(first, last, pred, proj);
-			} else {
-				I middle = first + iter_difference_t<I>(last - first) / 2;
-				inplace_stable_sort(first, middle, pred, proj);
-				inplace_stable_sort(middle, last, pred, proj);
-				detail::inplace_merge_no_buffer(first, middle, last,
-					middle - first, last - middle,
-					__stl2::ref(pred), __stl2::ref(proj));
+		static void random_access_stable_sort(I first, I last, C &comp, P &proj) {
+			using D = iter_difference_t<I>;
+			const auto n = D(last - first);
+			if (n <= min_run) {
+				detail::rsort::insertion_sort(first, last, comp, proj);
+				return;
 			}
-		}
+			auto buf = n > 256 ? buf_t<I>{(n + 1) / 2} : buf_t<I>{};
 
-		template<RandomAccessIterator I, WeaklyIncrementable O, class C, class P>
-		requires Sortable<I, C, P>
-		static void merge_sort_loop(I first, I last, O result,
-			iter_difference_t<I> step_size, C &pred, P &proj) {
-			auto two_step = iter_difference_t<I>(2 * step_size);
-			while (last - first >= two_step) {
-				result = merge(
-					__stl2::make_move_iterator(first),
-					__stl2::make_move_iterator(first + step_size),
-					__stl2::make_move_iterator(first + step_size),
-					__stl2::make_move_iterator(first + two_step),
-					result, __stl2::ref(pred),
-					__stl2::ref(proj), __stl2::ref(proj)).out;
-				first += two_step;
+			// The runs waiting to be merged, and the power of the boundary
+			// after each. The powers strictly increase from the bottom of
+			// the stack, so it never holds more than one run per bit of D.
+			struct pending_run {
+				D begin;
+				D size;
+				int power;
+			};
+			pending_run stack[std::numeric_limits<D>::digits + 1];
+			int depth = 0;
+
+			D begin = 0;
+			D size = extend_run(first, begin, n, comp, proj);
+			while (begin + size != n) {
+				const D next_begin = begin + size;
+				const D next_size = extend_run(first, next_begin, n, comp, proj);
+				const int power = node_power(begin, size, next_size, n);
+				while (depth > 0 && stack[depth - 1].power > power) {
+					auto& prev = stack[--depth];
+					merge_runs(first + prev.begin, first + begin,
+						first + (begin + size), buf, comp, proj);
+					size += begin - prev.begin;
+					begin = prev.begin;
+				}
+				stack[depth++] = {begin, size, power};
+				begin = next_begin;
+				size = next_size;
+			}
+			while (depth > 0) {
+				auto& prev = stack[--depth];
+				merge_runs(first + prev.begin, first + begin, first + n,
+					buf, comp, proj);
+				begin = prev.begin;
 			}
-			step_size = min(iter_difference_t<I>(last - first), step_size);
-			merge(
-				__stl2::make_move_iterator(first),
-				__stl2::make_move_iterator(first + step_size),
-				__stl2::make_move_iterator(first + step_size),
-				__stl2::make_move_iterator(last),
-				result, __stl2::ref(pred),
-				__stl2::ref(proj), __stl2::ref(proj));
 		}
 
+		// Runs shorter than this are extended by insertion sort.
+		static constexpr int min_run = 24;
+
+		// Returns the length of the run starting at first + begin, after
+		// reversing it if it strictly descends and extending it to
+		// min_run elements if it is shorter.
 		template<RandomAccessIterator I, class C, class P>
 		requires Sortable<I, C, P>
-		static void chunk_insertion_sort(I first, I last,
-			iter_difference_t<I> chunk_size, C &comp, P &proj) {
-			while (last - first >= chunk_size) {
-				detail::rsort::insertion_sort(first, first + chunk_size, comp, proj);
-				first += chunk_size;
+		static iter_difference_t<I> extend_run(I first, iter_difference_t<I> begin,
+			iter_difference_t<I> n, C &comp, P &proj) {
+			auto pred = [&](iter_difference_t<I> i) {
+				return __stl2::invoke(comp, __stl2::invoke(proj, first[i]),
+					__stl2::invoke(proj, first[i - 1]));
+			};
+			auto end = begin + 1;
+			if (end != n) {
+				if (pred(end)) {
+					// Strictly, so that reversing keeps equal elements in order.
+					do ++end; while (end != n && pred(end));
+					reverse(first + begin, first + end);
+				} else {
+					do ++end; while (end != n && !pred(end));
+				}
 			}
-			detail::rsort::insertion_sort(first, last, comp, proj);
+			if (end - begin < min_run && end != n) {
+				end = n - begin > min_run ? begin + min_run : n;
+				detail::rsort::insertion_sort(first + begin, first + end, comp, proj);
+			}
+			return end - begin;
 		}
 
-		template<RandomAccessIterator I, class C, class P>
-		requires Sortable<I, C, P>
-		static void merge_sort_with_buffer(I first, I last, buf_t<I>& buf, C &comp, P &proj) {
-			auto len = iter_difference_t<I>(last - first);
-			auto step_size = iter_difference_t<I>(merge_sort_chunk_size);
-			chunk_insertion_sort(first, last, step_size, comp, proj);
-			if (step_size >= len) {
-				return;
-			}
-			detail::temporary_vector<iter_value_t<I>> vec{buf};
-			merge_sort_loop(first, last, __stl2::back_inserter(vec), step_size, comp, proj);
-			step_size *= 2;
+		// The power of the boundary between the runs [b, b + n1) and
+		// [b + n1, b + n1 + n2) of a range of length n: the depth in the
+		// perfectly balanced merge tree of [0, n) at which their
+		// midpoints separate. Computed bit by bit as in CPython's
+		// listsort, on twice the midpoints to stay in integers. These
+		// stay below 2 * n, which may not fit D but fits its unsigned
+		// counterpart.
+		template<class D>
+		static int node_power(D b, D n1, D n2, D n) noexcept {
+			using U = std::make_unsigned_t<D>;
+			const auto length = static_cast<U>(n);
+			U x = 2 * static_cast<U>(b) + static_cast<U>(n1);
+			U y = x + static_cast<U>(n1) + static_cast<U>(n2);
+			int power = 0;
 			while (true) {
-				merge_sort_loop(vec.begin(), vec.end(), first, step_size, comp, proj);
-				step_size *= 2;
-				if (step_size >= len) {
-					return;
+				++power;
+				if (x >= length) {
+					x -= length;
+					y -= length;
+				} else if (y >= length) {
+					return power;
 				}
-				merge_sort_loop(first, last, vec.begin(), step_size, comp, proj);
-				step_size *= 2;
+				x *= 2;
+				y *= 2;
 			}
 		}
 
+		// Merges the adjacent sorted runs [first, middle) and
+		// [middle, last), first skipping the prefix of [first, middle)
+		// and the suffix of [middle, last) that are already in place.
 		template<RandomAccessIterator I, class C, class P>
 		requires Sortable<I, C, P>
-		static void stable_sort_adaptive(I first, I last, buf_t<I>& buf, C &comp, P &proj) {
-			auto len = iter_difference_t<I>((last - first + 1) / 2);
-			auto middle = first + len;
-			if (len > buf.size()) {
-				stable_sort_adaptive(first, middle, buf, comp, proj);
-				stable_sort_adaptive(middle, last, buf, comp, proj);
-			} else {
-				merge_sort_with_buffer(first, middle, buf, comp, proj);
-				merge_sort_with_buffer(middle, last, buf, comp, proj);
-			}
+		static void merge_runs(I first, I middle, I last, buf_t<I>& buf,
+			C &comp, P &proj) {
+			if (!__stl2::invoke(comp, __stl2::invoke(proj, *middle),
+				__stl2::invoke(proj, *prev(middle)))) return;
+			first = upper_bound(first, middle, __stl2::invoke(proj, *middle),
+				__stl2::ref(comp), __stl2::ref(proj));
+			last = lower_bound(middle, last, __stl2::invoke(proj, *prev(middle)),
+				__stl2::ref(comp), __stl2::ref(proj));
 			detail::merge_adaptive(first, middle, last,
 				middle - first, last - middle, buf,
 				__stl2::ref(comp), __stl2::ref(proj));
 		}
+
+		// Sorts the two halves on different threads, recursively, down to
+		// ranges of length cutoff. Each of those is sorted with its own
+		// buffer, as is each merge.
+		template<RandomAccessIterator I, class C, class P>
+		requires Sortable<I, C, P>
+		static void parallel_stable_sort(I first, I last,
+			iter_difference_t<I> cutoff, C &comp, P &proj) {
+			auto len = iter_difference_t<I>(last - first);
+			if (len <= cutoff) {
+				random_access_stable_sort(first, last, comp, proj);
+				return;
+			}
+			auto middle = first + len / 2;
+			{
+				detail::task_group tasks;
+				tasks.run([=, &comp, &proj] {
+					parallel_stable_sort(first, middle, cutoff, comp, proj);
+				});
+				parallel_stable_sort(middle, last, cutoff, comp, proj);
+				tasks.wait();
+			}
+			inplace_merge(first, middle, last, __stl2::ref(comp),
+				__stl2::ref(proj));
+		}
 	};
 
 	inline constexpr __stable_sort_fn stable_sort {};
@@ -15,6 +15,7 @@
 
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/execution.hpp>
 #include <stl2/detail/range/primitives.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -78,6 +79,83 @@ STL2_OPEN_NAMESPACE {
 			return (*this)(begin(r1), end(r1), begin(r2), end(r2), std::move(result),
 				__stl2::ref(op), __stl2::ref(proj1), __stl2::ref(proj2));
 		}
+
+		/// Extension: parallel transform
+		///
+		template<RandomAccessIterator I, SizedSentinel<I> S, RandomAccessIterator O,
+			CopyConstructible F, class Proj = identity>
+		requires Writable<O, indirect_result_t<F&, projected<I, Proj>>>
+		unary_transform_result<I, O>
+		operator()(const ext::parallel_policy& policy, I first, S last, O result,
+			F op, Proj proj = {}) const
+		{
+			const auto n = iter_difference_t<I>(last - first);
+			detail::parallel_for(policy, n, [&](auto b, auto e) {
+				auto out = result + static_cast<iter_difference_t<O>>(b);
+				for (auto i = first + b, end = first + e; i != end; (void) ++i, (void) ++out) {
+					*out = __stl2::invoke(op, __stl2::invoke(proj, *i));
+				}
+			});
+			return {first + n, result + static_cast<iter_difference_t<O>>(n)};
+		}
+
+		template<RandomAccessRange R, RandomAccessIterator O, CopyConstructible F,
+			class Proj = identity>
+		requires SizedRange<R> &&
+			Writable<O, indirect_result_t<F&, projected<iterator_t<R>, Proj>>>
+		unary_transform_result<safe_iterator_t<R>, O>
+		operator()(const ext::parallel_policy& policy, R&& r, O result, F op,
+			Proj proj = {}) const
+		{
+			auto first = begin(r);
+			return (*this)(policy, first, first + distance(r), std::move(result),
+				__stl2::ref(op), __stl2::ref(proj));
+		}
+
+		template<RandomAccessIterator I1, SizedSentinel<I1> S1,
+			RandomAccessIterator I2, SizedSentinel<I2> S2,
+			RandomAccessIterator O, CopyConstructible F,
+			class Proj1 = identity, class Proj2 = identity>
+		requires Writable<O, indirect_result_t<F&,
+			projected<I1, Proj1>, projected<I2, Proj2>>>
+		binary_transform_result<I1, I2, O>
+		operator()(const ext::parallel_policy& policy, I1 first1, S1 last1,
+			I2 first2, S2 last2, O result, F op, Proj1 proj1 = {},
+			Proj2 proj2 = {}) const
+		{
+			using D = iter_difference_t<I1>;
+			const auto n1 = D(last1 - first1);
+			const auto n2 = last2 - first2;
+			const auto n = n2 < n1 ? D(n2) : n1;
+			detail::parallel_for(policy, n, [&](D b, D e) {
+				auto in2 = first2 + static_cast<iter_difference_t<I2>>(b);
+				auto out = result + static_cast<iter_difference_t<O>>(b);
+				for (auto i = first1 + b, end = first1 + e; i != end;
+				     (void) ++i, (void) ++in2, (void) ++out)
+				{
+					*out = __stl2::invoke(op, __stl2::invoke(proj1, *i),
+						__stl2::invoke(proj2, *in2));
+				}
+			});
+			return {first1 + n, first2 + static_cast<iter_difference_t<I2>>(n),
+				result + static_cast<iter_difference_t<O>>(n)};
+		}
+
+		template<RandomAccessRange R1, RandomAccessRange R2, RandomAccessIterator O,
+			CopyConstructible F, class Proj1 = identity, class Proj2 = identity>
+		requires SizedRange<R1> && SizedRange<R2> &&
+			Writable<O, indirect_result_t<F&,
+				projected<iterator_t<R1>, Proj1>, projected<iterator_t<R2>, Proj2>>>
+		binary_transform_result<safe_iterator_t<R1>, safe_iterator_t<R2>, O>
+		operator()(const ext::parallel_policy& policy, R1&& r1, R2&& r2, O result,
+			F op, Proj1 proj1 = {}, Proj2 proj2 = {}) const
+		{
+			auto first1 = begin(r1);
+			auto first2 = begin(r2);
+			return (*this)(policy, first1, first1 + distance(r1), first2,
+				first2 + distance(r2), std::move(result), __stl2::ref(op),
+				__stl2::ref(proj1), __stl2::ref(proj2));
+		}
 	};
 
 	inline constexpr __transform_fn transform {};
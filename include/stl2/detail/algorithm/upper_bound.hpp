@@ -31,6 +31,12 @@ STL2_OPEN_NAMESPACE {
 				auto pred = [&](auto&& i) {
 					return !__stl2::invoke(comp, value, i);
 				};
+				if constexpr (detail::BranchlessSearchable<__f<I>, T, Comp, Proj>) {
+					if (!detail::is_constant_evaluated()) {
+						return detail::branchless_partition_point_n(
+							std::forward<I>(first_), n, std::move(pred));
+					}
+				}
 				return ext::partition_point_n(std::forward<I>(first_), n,
 					std::move(pred), __stl2::ref(proj));
 			}
@@ -0,0 +1,113 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_EXECUTION_HPP
+#define STL2_DETAIL_EXECUTION_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/thread_pool.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// parallel_policy [Extension]
+//
+// Passing ext::par as the first argument of an algorithm that supports it
+// permits the algorithm to run on the threads of detail::thread_pool.
+// Function objects are invoked concurrently through a shared reference,
+// and must tolerate that; exceptions they throw propagate to the caller
+// once all running tasks have finished.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		struct parallel_policy {
+			// Ranges shorter than this are not worth splitting.
+			std::ptrdiff_t grain = 1 << 14;
+		};
+
+		inline constexpr parallel_policy par {};
+	}
+
+	namespace detail {
+		// The size of the pieces a parallel algorithm should split a range
+		// of length n into: several per thread for load balancing, but no
+		// smaller than the policy's grain.
+		inline std::ptrdiff_t parallel_chunk(const ext::parallel_policy& policy,
+			std::ptrdiff_t n) noexcept
+		{
+			const auto pieces = static_cast<std::ptrdiff_t>(
+				4 * thread_pool::instance().concurrency());
+			const auto chunk = (n + pieces - 1) / pieces;
+			return chunk > policy.grain ? chunk : policy.grain;
+		}
+
+		// Invokes body(b, e) for consecutive pieces [b, e) covering [0, n),
+		// on the pool if there is more than one.
+		template<class D, class Body>
+		void parallel_for(const ext::parallel_policy& policy, D n, Body body) {
+			const auto chunk = static_cast<D>(
+				parallel_chunk(policy, static_cast<std::ptrdiff_t>(n)));
+			if (n <= chunk) {
+				if (n > 0) body(D{0}, n);
+				return;
+			}
+			task_group tasks;
+			for (D b = 0; b < n; b += chunk) {
+				const D e = n - b > chunk ? b + chunk : n;
+				tasks.run([&body, b, e] { body(b, e); });
+			}
+			tasks.wait();
+		}
+
+		// Returns the least i in [0, n) for which found(i), or n if there is
+		// none. Pieces are searched concurrently, and abandon the search
+		// once a match is known before them; if any_match, once any match
+		// is known, in which case the result is some match.
+		template<class D, class Found>
+		D parallel_find(const ext::parallel_policy& policy, D n, Found found,
+			bool any_match = false)
+		{
+			const auto chunk = static_cast<D>(
+				parallel_chunk(policy, static_cast<std::ptrdiff_t>(n)));
+			if (n <= chunk) {
+				D i = 0;
+				while (i < n && !found(i)) ++i;
+				return i;
+			}
+			std::atomic<D> best{n};
+			task_group tasks;
+			for (D b = 0; b < n; b += chunk) {
+				const D e = n - b > chunk ? b + chunk : n;
+				tasks.run([&, b, e] {
+					// Look for a reason to stop every block elements.
+					constexpr D block = 1024;
+					for (D i = b; i < e;) {
+						const D limit = best.load(std::memory_order_relaxed);
+						if (any_match ? limit != n : limit <= i) return;
+						const D stop = e - i > block ? i + block : e;
+						for (; i < stop; ++i) {
+							if (found(i)) {
+								D current = best.load(std::memory_order_relaxed);
+								while (i < current && !best.compare_exchange_weak(current, i)) {}
+								if (any_match) tasks.cancel();
+								return;
+							}
+						}
+					}
+				});
+			}
+			tasks.wait();
+			return best.load();
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
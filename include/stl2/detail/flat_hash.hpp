@@ -0,0 +1,644 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_FLAT_HASH_HPP
+#define STL2_DETAIL_FLAT_HASH_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <stl2/functional.hpp>
+#include <stl2/detail/compressed_pair.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/hash.hpp>
+#include <stl2/detail/meta.hpp>
+#include <stl2/detail/concepts/function.hpp>
+#include <stl2/detail/concepts/object.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/simd/group.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// flat_hash_set and flat_hash_map [Extension]
+//
+// Open-addressing hash tables after Abseil's SwissTable. Elements live in
+// a single array of slots, next to an array of one control byte per slot:
+// empty, deleted, or the low 7 bits ("H2") of the hash of the element in
+// the slot. A lookup starts at a position given by the rest of the hash
+// ("H1") and compares H2 against a group of 16 control bytes at once, so
+// it touches the slots only of likely matches, and usually a single
+// cache line of control bytes. Erasure leaves a deleted marker so that
+// probe sequences stay intact; the table is rehashed when markers and
+// elements leave too few empty slots.
+//
+// Unlike the node-based std::unordered_map, rehashing moves elements, and
+// invalidates iterators, pointers and references to them. Keys of a
+// flat_hash_map are const, so rehashing copies them unless they are
+// cheap to move.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail::swiss {
+		using ctrl_t = signed char;
+		inline constexpr ctrl_t ctrl_empty = -128;
+		inline constexpr ctrl_t ctrl_deleted = -2;
+		// Follows the last slot's control byte, to stop iteration.
+		inline constexpr ctrl_t ctrl_sentinel = -1;
+
+		inline constexpr std::size_t group_width = 16;
+
+		// The control bytes of tables with no slots: iteration stops at
+		// once, and nothing ever writes them.
+		alignas(group_width) inline ctrl_t empty_group[group_width] = {
+			ctrl_sentinel, ctrl_empty, ctrl_empty, ctrl_empty,
+			ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+			ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+			ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty
+		};
+
+		// At most 7/8 of the slots hold elements or deleted markers.
+		constexpr std::size_t max_load(std::size_t capacity) noexcept {
+			return capacity - capacity / 8;
+		}
+
+		// Visits groups at offsets from the starting position that grow by
+		// group_width, 2 * group_width, and so on: the triangular
+		// multiples of group_width visit every group of a table whose
+		// number of positions, mask + 1, is a power of two.
+		struct probe_seq {
+			std::size_t mask;
+			std::size_t offset;
+			std::size_t index = 0;
+
+			void next() noexcept {
+				index += group_width;
+				offset = (offset + index) & mask;
+			}
+		};
+
+		template<class K>
+		struct set_policy {
+			using key_type = K;
+			using value_type = K;
+			static constexpr bool mutable_values = false;
+
+			static const K& key(const value_type& v) noexcept {
+				return v;
+			}
+		};
+
+		template<class K, class V>
+		struct map_policy {
+			using key_type = K;
+			using value_type = std::pair<const K, V>;
+			static constexpr bool mutable_values = true;
+
+			static const K& key(const value_type& v) noexcept {
+				return v.first;
+			}
+		};
+
+		template<class Policy, class Hash, class Eq>
+		class table {
+		public:
+			using key_type = typename Policy::key_type;
+			using value_type = typename Policy::value_type;
+			using size_type = std::size_t;
+			using difference_type = std::ptrdiff_t;
+			using hasher = Hash;
+			using key_equal = Eq;
+
+		private:
+			template<bool Const>
+			class __iterator {
+			public:
+				using value_type = typename Policy::value_type;
+				using difference_type = std::ptrdiff_t;
+				using reference = meta::if_c<Const || !Policy::mutable_values,
+					const value_type&, value_type&>;
+				using iterator_category = __stl2::forward_iterator_tag;
+
+			private:
+				friend table;
+				friend __iterator<!Const>;
+
+				const ctrl_t* ctrl_ = nullptr;
+				value_type* slot_ = nullptr;
+
+				__iterator(const ctrl_t* ctrl, value_type* slot) noexcept
+				: ctrl_{ctrl}, slot_{slot} {}
+
+				// Advances past empty slots and deleted markers, a group
+				// at a time, to an element or the sentinel.
+				void skip_empty() noexcept {
+					while (*ctrl_ < ctrl_sentinel) {
+						const unsigned special = simd::match_lt16(ctrl_, ctrl_sentinel);
+						const auto n = __builtin_ctz(~special);
+						ctrl_ += n;
+						slot_ += n;
+					}
+				}
+			public:
+				__iterator() = default;
+				__iterator(const __iterator<!Const>& that) noexcept
+				requires Const
+				: ctrl_{that.ctrl_}, slot_{that.slot_} {}
+
+				reference operator*() const noexcept {
+					return *slot_;
+				}
+				std::add_pointer_t<reference> operator->() const noexcept {
+					return slot_;
+				}
+
+				__iterator& operator++() noexcept {
+					++ctrl_;
+					++slot_;
+					skip_empty();
+					return *this;
+				}
+				__iterator operator++(int) noexcept {
+					auto tmp = *this;
+					++*this;
+					return tmp;
+				}
+
+				friend bool operator==(const __iterator& x, const __iterator& y) noexcept {
+					return x.ctrl_ == y.ctrl_;
+				}
+				friend bool operator!=(const __iterator& x, const __iterator& y) noexcept {
+					return !(x == y);
+				}
+			};
+
+		public:
+			using iterator = __iterator<false>;
+			using const_iterator = __iterator<true>;
+
+			table() = default;
+
+			explicit table(size_type n, const Hash& hash = Hash(), const Eq& eq = Eq())
+			: fns_{hash, eq} {
+				reserve(n);
+			}
+
+			template<InputIterator I, Sentinel<I> S>
+			requires Constructible<value_type, iter_reference_t<I>>
+			table(I first, S last, size_type n = 0,
+				const Hash& hash = Hash(), const Eq& eq = Eq())
+			: table(n, hash, eq) {
+				insert(std::move(first), std::move(last));
+			}
+
+			table(std::initializer_list<value_type> il, size_type n = 0,
+				const Hash& hash = Hash(), const Eq& eq = Eq())
+			: table(il.begin(), il.end(), n < il.size() ? il.size() : n, hash, eq) {}
+
+			table(const table& that)
+			: table(that.size_, that.hash_function(), that.key_eq()) {
+				// The elements are distinct: no need to look them up.
+				for (const value_type& v : that) {
+					construct_at(prepare_insert(hash_of(Policy::key(v))), [&](void* p) {
+						::new (p) value_type(v);
+					});
+				}
+			}
+
+			table(table&& that) noexcept
+			: ctrl_{std::exchange(that.ctrl_, empty_group)}
+			, slots_{std::exchange(that.slots_, nullptr)}
+			, size_{std::exchange(that.size_, 0)}
+			, capacity_{std::exchange(that.capacity_, 0)}
+			, growth_left_{std::exchange(that.growth_left_, 0)}
+			, fns_{that.fns_} {}
+
+			table& operator=(const table& that) {
+				if (this != &that) {
+					table tmp{that};
+					swap(tmp);
+				}
+				return *this;
+			}
+
+			table& operator=(table&& that) noexcept {
+				table tmp{std::move(that)};
+				swap(tmp);
+				return *this;
+			}
+
+			~table() {
+				release();
+			}
+
+			void swap(table& that) noexcept {
+				using std::swap;
+				swap(ctrl_, that.ctrl_);
+				swap(slots_, that.slots_);
+				swap(size_, that.size_);
+				swap(capacity_, that.capacity_);
+				swap(growth_left_, that.growth_left_);
+				swap(fns_, that.fns_);
+			}
+
+			friend void swap(table& x, table& y) noexcept {
+				x.swap(y);
+			}
+
+			iterator begin() noexcept {
+				iterator i{ctrl_, slots_};
+				i.skip_empty();
+				return i;
+			}
+			const_iterator begin() const noexcept {
+				return const_cast<table&>(*this).begin();
+			}
+			iterator end() noexcept {
+				return {ctrl_ + capacity_, slots_ + capacity_};
+			}
+			const_iterator end() const noexcept {
+				return const_cast<table&>(*this).end();
+			}
+
+			size_type size() const noexcept {
+				return size_;
+			}
+			bool empty() const noexcept {
+				return size_ == 0;
+			}
+			// The number of slots: zero, or one less than a power of two.
+			size_type capacity() const noexcept {
+				return capacity_;
+			}
+
+			hasher hash_function() const {
+				return fns_.first();
+			}
+			key_equal key_eq() const {
+				return fns_.second();
+			}
+
+			void clear() noexcept {
+				destroy_elements();
+				if (capacity_) {
+					reset_ctrl();
+				}
+			}
+
+			// Makes room for n elements without rehashing.
+			void reserve(size_type n) {
+				if (n > size_ + growth_left_) {
+					size_type capacity = group_width - 1;
+					while (max_load(capacity) < n) capacity = 2 * capacity + 1;
+					resize(capacity);
+				}
+			}
+
+			std::pair<iterator, bool> insert(const value_type& v) {
+				return find_or_emplace(Policy::key(v), [&](void* p) {
+					::new (p) value_type(v);
+				});
+			}
+			std::pair<iterator, bool> insert(value_type&& v) {
+				return find_or_emplace(Policy::key(v), [&](void* p) {
+					::new (p) value_type(std::move(v));
+				});
+			}
+			template<InputIterator I, Sentinel<I> S>
+			requires Constructible<value_type, iter_reference_t<I>>
+			void insert(I first, S last) {
+				for (; first != last; ++first) {
+					emplace(*first);
+				}
+			}
+			void insert(std::initializer_list<value_type> il) {
+				insert(il.begin(), il.end());
+			}
+
+			template<class... Args>
+			requires Constructible<value_type, Args...>
+			std::pair<iterator, bool> emplace(Args&&... args) {
+				value_type v(std::forward<Args>(args)...);
+				return insert(std::move(v));
+			}
+
+			iterator find(const key_type& k) {
+				return iterator_at(find_index(k, hash_of(k)));
+			}
+			const_iterator find(const key_type& k) const {
+				return const_cast<table&>(*this).find(k);
+			}
+			bool contains(const key_type& k) const {
+				return find_index(k, hash_of(k)) != capacity_;
+			}
+			size_type count(const key_type& k) const {
+				return contains(k) ? 1 : 0;
+			}
+
+			// Returns an iterator to the element after pos.
+			iterator erase(const_iterator pos) {
+				const auto i = static_cast<size_type>(pos.slot_ - slots_);
+				erase_at(i);
+				iterator next{ctrl_ + i, slots_ + i};
+				next.skip_empty();
+				return next;
+			}
+			size_type erase(const key_type& k) {
+				const auto i = find_index(k, hash_of(k));
+				if (i == capacity_) return 0;
+				erase_at(i);
+				return 1;
+			}
+
+		protected:
+			// Finds the element with key k, or constructs one with
+			// construct(p), which must construct an element with key k at p.
+			template<class F>
+			std::pair<iterator, bool> find_or_emplace(const key_type& k, F construct) {
+				const auto h = hash_of(k);
+				auto i = find_index(k, h);
+				if (i != capacity_) return {iterator_at(i), false};
+				i = prepare_insert(h);
+				construct_at(i, construct);
+				return {iterator_at(i), true};
+			}
+
+		private:
+			ctrl_t* ctrl_ = empty_group;
+			value_type* slots_ = nullptr;
+			size_type size_ = 0;
+			size_type capacity_ = 0;
+			// The number of empty slots that may still be filled.
+			size_type growth_left_ = 0;
+			ext::compressed_pair<Hash, Eq> fns_;
+
+			size_type hash_of(const key_type& k) const {
+				const size_type h = __stl2::invoke(fns_.first(), k);
+				// ext::hash is already well mixed; other hashers, like the
+				// identity std::hash of most standard libraries, may not be.
+				if constexpr (Same<Hash, __hash::__fn>) {
+					return h;
+				} else {
+					return static_cast<size_type>(hash_mix(h));
+				}
+			}
+
+			static ctrl_t h2(size_type h) noexcept {
+				return static_cast<ctrl_t>(h & 0x7f);
+			}
+
+			probe_seq probe(size_type h) const noexcept {
+				return {capacity_, (h >> 7) & capacity_};
+			}
+
+			iterator iterator_at(size_type i) noexcept {
+				return {ctrl_ + i, slots_ + i};
+			}
+
+			// Probe positions run modulo capacity_ + 1, a power of two;
+			// position capacity_ holds the sentinel, which matches nothing.
+			// The control bytes of the first group_width - 1 slots are
+			// cloned after it, so that a group may start at any position.
+			void set_ctrl(size_type i, ctrl_t c) noexcept {
+				ctrl_[i] = c;
+				if (i < group_width - 1) {
+					ctrl_[capacity_ + 1 + i] = c;
+				}
+			}
+
+			void reset_ctrl() noexcept {
+				std::memset(ctrl_, static_cast<unsigned char>(ctrl_empty), capacity_ + group_width);
+				ctrl_[capacity_] = ctrl_sentinel;
+				growth_left_ = max_load(capacity_);
+			}
+
+			// Returns the index of the element with key k, whose hash is h,
+			// or capacity_ if there is none.
+			size_type find_index(const key_type& k, size_type h) const {
+				if (capacity_ == 0) return 0;
+				auto seq = probe(h);
+				while (true) {
+					const ctrl_t* g = ctrl_ + seq.offset;
+					for (auto bits = simd::match_eq16(g, h2(h)); bits; bits &= bits - 1) {
+						const auto i = (seq.offset + __builtin_ctz(bits)) & seq.mask;
+						if (__stl2::invoke(fns_.second(), Policy::key(slots_[i]), k)) {
+							return i;
+						}
+					}
+					if (simd::match_eq16(g, ctrl_empty)) return capacity_;
+					seq.next();
+				}
+			}
+
+			// Returns the index of the first empty or deleted slot in the
+			// probe sequence of h.
+			size_type find_first_non_full(size_type h) const noexcept {
+				auto seq = probe(h);
+				while (true) {
+					const auto bits = simd::match_lt16(ctrl_ + seq.offset, ctrl_sentinel);
+					if (bits) return (seq.offset + __builtin_ctz(bits)) & seq.mask;
+					seq.next();
+				}
+			}
+
+			// Claims a slot for a new element whose hash is h, growing the
+			// table if need be, and returns its index.
+			size_type prepare_insert(size_type h) {
+				size_type i = 0;
+				if (capacity_ != 0) i = find_first_non_full(h);
+				if (growth_left_ == 0 && (capacity_ == 0 || ctrl_[i] != ctrl_deleted)) {
+					// Reclaim the deleted markers in place if that frees at
+					// least 3/32 of the slots; grow otherwise.
+					if (capacity_ == 0) {
+						resize(group_width - 1);
+					} else if (size_ * 32 <= capacity_ * 25) {
+						resize(capacity_);
+					} else {
+						resize(2 * capacity_ + 1);
+					}
+					i = find_first_non_full(h);
+				}
+				growth_left_ -= ctrl_[i] == ctrl_empty;
+				set_ctrl(i, h2(h));
+				++size_;
+				return i;
+			}
+
+			// Constructs an element in slot i, claimed by prepare_insert,
+			// with construct(p).
+			template<class F>
+			void construct_at(size_type i, F&& construct) {
+				try {
+					construct(static_cast<void*>(slots_ + i));
+				} catch (...) {
+					// The slot stays out of the growth budget until the next
+					// rehash, as if its element had been erased.
+					set_ctrl(i, ctrl_deleted);
+					--size_;
+					throw;
+				}
+			}
+
+			void erase_at(size_type i) noexcept {
+				slots_[i].~value_type();
+				set_ctrl(i, ctrl_deleted);
+				--size_;
+			}
+
+			// The control bytes, then the slots, in one allocation.
+			static constexpr std::size_t alignment =
+				alignof(value_type) > group_width ? alignof(value_type) : group_width;
+
+			static std::size_t slot_offset(size_type capacity) noexcept {
+				const auto n = capacity + group_width;
+				return (n + alignof(value_type) - 1) / alignof(value_type) * alignof(value_type);
+			}
+
+			static std::size_t allocation_size(size_type capacity) noexcept {
+				return slot_offset(capacity) + capacity * sizeof(value_type);
+			}
+
+			// Moves the elements into a table of capacity slots. If
+			// moving an element can throw it is copied instead, so that
+			// the table is unchanged should that throw.
+			void resize(size_type capacity) {
+				table fresh(0, fns_.first(), fns_.second());
+				auto memory = static_cast<unsigned char*>(::operator new(
+					allocation_size(capacity), std::align_val_t{alignment}));
+				fresh.ctrl_ = reinterpret_cast<ctrl_t*>(memory);
+				fresh.slots_ = reinterpret_cast<value_type*>(memory + slot_offset(capacity));
+				fresh.capacity_ = capacity;
+				fresh.reset_ctrl();
+				for (auto& v : *this) {
+					const auto i = fresh.prepare_insert(fresh.hash_of(Policy::key(v)));
+					fresh.construct_at(i, [&](void* p) {
+						::new (p) value_type(std::move_if_noexcept(const_cast<value_type&>(v)));
+					});
+				}
+				swap(fresh);
+			}
+
+			void destroy_elements() noexcept {
+				if constexpr (!std::is_trivially_destructible_v<value_type>) {
+					for (auto& v : *this) {
+						const_cast<value_type&>(v).~value_type();
+					}
+				}
+				size_ = 0;
+			}
+
+			void release() noexcept {
+				if (capacity_ == 0) return;
+				destroy_elements();
+				::operator delete(ctrl_, allocation_size(capacity_),
+					std::align_val_t{alignment});
+				ctrl_ = empty_group;
+				slots_ = nullptr;
+				capacity_ = 0;
+				growth_left_ = 0;
+			}
+		};
+	}
+
+	namespace ext {
+		template<Movable K, class Hash = __hash::__fn, class Eq = equal_to>
+		requires Invocable<const Hash&, const K&> && Relation<const Eq&, K, K>
+		class flat_hash_set
+		: public detail::swiss::table<detail::swiss::set_policy<K>, Hash, Eq>
+		{
+			using base_t = detail::swiss::table<detail::swiss::set_policy<K>, Hash, Eq>;
+		public:
+			using base_t::base_t;
+
+			flat_hash_set() = default;
+		};
+
+		template<Movable K, class V, class Hash = __hash::__fn, class Eq = equal_to>
+		requires Invocable<const Hash&, const K&> && Relation<const Eq&, K, K>
+		class flat_hash_map
+		: public detail::swiss::table<detail::swiss::map_policy<K, V>, Hash, Eq>
+		{
+			using base_t = detail::swiss::table<detail::swiss::map_policy<K, V>, Hash, Eq>;
+		public:
+			using mapped_type = V;
+			using typename base_t::iterator;
+			using typename base_t::value_type;
+
+			using base_t::base_t;
+
+			flat_hash_map() = default;
+
+			template<class... Args>
+			requires Constructible<V, Args...>
+			std::pair<iterator, bool> try_emplace(const K& k, Args&&... args) {
+				return this->find_or_emplace(k, [&](void* p) {
+					::new (p) value_type(std::piecewise_construct,
+						std::forward_as_tuple(k),
+						std::forward_as_tuple(std::forward<Args>(args)...));
+				});
+			}
+			template<class... Args>
+			requires Constructible<V, Args...>
+			std::pair<iterator, bool> try_emplace(K&& k, Args&&... args) {
+				return this->find_or_emplace(k, [&](void* p) {
+					::new (p) value_type(std::piecewise_construct,
+						std::forward_as_tuple(std::move(k)),
+						std::forward_as_tuple(std::forward<Args>(args)...));
+				});
+			}
+
+			template<class M>
+			requires Assignable<V&, M> && Constructible<V, M>
+			std::pair<iterator, bool> insert_or_assign(const K& k, M&& m) {
+				auto result = try_emplace(k, std::forward<M>(m));
+				if (!result.second) result.first->second = std::forward<M>(m);
+				return result;
+			}
+			template<class M>
+			requires Assignable<V&, M> && Constructible<V, M>
+			std::pair<iterator, bool> insert_or_assign(K&& k, M&& m) {
+				auto result = try_emplace(std::move(k), std::forward<M>(m));
+				if (!result.second) result.first->second = std::forward<M>(m);
+				return result;
+			}
+
+			V& operator[](const K& k)
+			requires DefaultConstructible<V> {
+				return try_emplace(k).first->second;
+			}
+			V& operator[](K&& k)
+			requires DefaultConstructible<V> {
+				return try_emplace(std::move(k)).first->second;
+			}
+
+			V& at(const K& k) {
+				auto i = this->find(k);
+				if (i == this->end()) throw std::out_of_range{"flat_hash_map::at"};
+				return i->second;
+			}
+			const V& at(const K& k) const {
+				return const_cast<flat_hash_map&>(*this).at(k);
+			}
+		};
+	}
+
+	// Iterators of a flat_hash_set, like those of std::set, are all
+	// constant, which the default would take for a view's.
+	template<class K, class Hash, class Eq>
+	inline constexpr bool enable_view<ext::flat_hash_set<K, Hash, Eq>> = false;
+	template<class K, class V, class Hash, class Eq>
+	inline constexpr bool enable_view<ext::flat_hash_map<K, V, Hash, Eq>> = false;
+} STL2_CLOSE_NAMESPACE
+
+#endif
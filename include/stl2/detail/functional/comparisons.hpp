@@ -91,6 +91,32 @@ STL2_OPEN_NAMESPACE {
 
 		using is_transparent = std::true_type;
 	};
+
+	///////////////////////////////////////////////////////////////////////////
+	// compare_to [Extension]
+	// A unary predicate comparing its argument with a fixed value:
+	// compare_to{less{}, 42}(x) is less{}(x, 42). Algorithms that filter
+	// contiguous ranges of arithmetic elements evaluate it several elements
+	// at a time when comp is one of the comparison objects above and value
+	// has the element type.
+	//
+	namespace ext {
+		template<class Comp, class T>
+		struct compare_to {
+			Comp comp;
+			T value;
+
+			template<class U>
+			constexpr auto operator()(U&& u) const
+			-> decltype(std::declval<const Comp&>()(std::forward<U>(u), std::declval<const T&>()))
+			{
+				return comp(std::forward<U>(u), value);
+			}
+		};
+
+		template<class Comp, class T>
+		compare_to(Comp, T) -> compare_to<Comp, T>;
+	}
 } STL2_CLOSE_NAMESPACE
 
 #endif
@@ -23,6 +23,9 @@
  #define STL2_HAS_BUILTIN(X) STL2_HAS_BUILTIN_ ## X
  #if defined(__GNUC__)
   #define STL2_HAS_BUILTIN_unreachable 1
+  #if __GNUC__ >= 9
+   #define STL2_HAS_BUILTIN_is_constant_evaluated 1
+  #endif
  #endif // __GNUC__
 #endif // __clang__
 
@@ -210,6 +213,20 @@ STL2_OPEN_NAMESPACE {
 		inline constexpr priority_tag<4> max_priority_tag{};
 	}
 
+	namespace detail {
+		// Distinguishes constant evaluation from runtime evaluation so that
+		// algorithms may dispatch to non-constexpr fast paths (memmove et al.)
+		// at runtime. Conservatively reports constant evaluation when the
+		// compiler provides no means to tell the difference.
+		constexpr bool is_constant_evaluated() noexcept {
+#if STL2_HAS_BUILTIN(is_constant_evaluated)
+			return __builtin_is_constant_evaluated();
+#else
+			return true;
+#endif
+		}
+	}
+
 	struct __niebloid {
 		explicit __niebloid() = default;
 		__niebloid(const __niebloid&) = delete;
@@ -13,34 +13,295 @@
 #define STL2_DETAIL_HASH_HPP
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <memory>
+#include <type_traits>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/concepts/core.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+#include <stl2/detail/range/access.hpp>
+#include <stl2/detail/range/concepts.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // Hash machinery.
 //
 STL2_OPEN_NAMESPACE {
+	///////////////////////////////////////////////////////////////////////////
+	// Mixing and byte hashing
+	//
+	// After wyhash (Wang Yi, public domain): the full 128-bit product of
+	// two 64-bit words, folded by xoring its halves, diffuses every input
+	// bit into every output bit in a single multiplication. Long inputs
+	// are consumed 48 bytes at a time in three independent lanes.
+	//
+	namespace detail {
+		inline constexpr std::uint64_t hash_secret[4] = {
+			0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+			0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+		};
+
+		// Replaces a and b with the low and high halves of their product.
+		constexpr void hash_mul(std::uint64_t& a, std::uint64_t& b) noexcept {
+#if defined(__SIZEOF_INT128__)
+			__extension__ typedef unsigned __int128 u128;
+			const auto r = static_cast<u128>(a) * b;
+			a = static_cast<std::uint64_t>(r);
+			b = static_cast<std::uint64_t>(r >> 64);
+#else
+			const std::uint64_t ha = a >> 32, la = a & 0xffffffff;
+			const std::uint64_t hb = b >> 32, lb = b & 0xffffffff;
+			const std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+			const std::uint64_t t = rl + (rm0 << 32);
+			std::uint64_t carry = t < rl;
+			const std::uint64_t lo = t + (rm1 << 32);
+			carry += lo < t;
+			a = lo;
+			b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+		}
+
+		constexpr std::uint64_t hash_mum(std::uint64_t a, std::uint64_t b) noexcept {
+			hash_mul(a, b);
+			return a ^ b;
+		}
+
+		// Scrambles the bits of x; used on the hashes of scalars, whose
+		// low bits are otherwise poorly distributed.
+		constexpr std::uint64_t hash_mix(std::uint64_t x) noexcept {
+			return hash_mum(x ^ hash_secret[0], hash_secret[1]);
+		}
+
+		// Folds the hash h of a further value into seed. Not symmetric:
+		// the order of the values matters.
+		constexpr std::uint64_t hash_combine(std::uint64_t seed, std::uint64_t h) noexcept {
+			return hash_mum(seed ^ hash_secret[0], h ^ hash_secret[1]);
+		}
+
+		inline std::uint64_t hash_read8(const unsigned char* p) noexcept {
+			std::uint64_t v;
+			std::memcpy(&v, p, 8);
+			return v;
+		}
+
+		inline std::uint64_t hash_read4(const unsigned char* p) noexcept {
+			std::uint32_t v;
+			std::memcpy(&v, p, 4);
+			return v;
+		}
+
+		// Hashes the n bytes at data.
+		inline std::uint64_t hash_bytes(const void* data, std::size_t n,
+			std::uint64_t seed = 0) noexcept
+		{
+			const auto* p = static_cast<const unsigned char*>(data);
+			const auto* s = hash_secret;
+			seed ^= hash_mum(seed ^ s[0], s[1]);
+			std::uint64_t a, b;
+			if (n <= 16) {
+				if (n >= 4) {
+					// Two overlapping pairs of 4-byte reads cover 4 to 16 bytes.
+					const std::size_t mid = (n >> 3) << 2;
+					a = (hash_read4(p) << 32) | hash_read4(p + mid);
+					b = (hash_read4(p + n - 4) << 32) | hash_read4(p + n - 4 - mid);
+				} else if (n > 0) {
+					a = (std::uint64_t{p[0]} << 16) | (std::uint64_t{p[n >> 1]} << 8) | p[n - 1];
+					b = 0;
+				} else {
+					a = b = 0;
+				}
+			} else {
+				std::size_t i = n;
+				if (i > 48) {
+					std::uint64_t seed1 = seed, seed2 = seed;
+					do {
+						seed = hash_mum(hash_read8(p) ^ s[1], hash_read8(p + 8) ^ seed);
+						seed1 = hash_mum(hash_read8(p + 16) ^ s[2], hash_read8(p + 24) ^ seed1);
+						seed2 = hash_mum(hash_read8(p + 32) ^ s[3], hash_read8(p + 40) ^ seed2);
+						p += 48;
+						i -= 48;
+					} while (i > 48);
+					seed ^= seed1 ^ seed2;
+				}
+				while (i > 16) {
+					seed = hash_mum(hash_read8(p) ^ s[1], hash_read8(p + 8) ^ seed);
+					i -= 16;
+					p += 16;
+				}
+				// The last 16 bytes, overlapping those already consumed.
+				a = hash_read8(p + i - 16);
+				b = hash_read8(p + i - 8);
+			}
+			a ^= s[1];
+			b ^= seed;
+			hash_mul(a, b);
+			return hash_mum(a ^ s[0] ^ n, b ^ s[1]);
+		}
+
+		// Hashes the elements of [first, last), as bytes when they are
+		// contiguous and hash_as_bytes, and otherwise by combining their
+		// ext::hash values. Defined below ext::hash.
+		template<class I, class S>
+		std::uint64_t hash_elements(I first, S last, std::uint64_t seed);
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// hash [Extension]
+	// A customization point object returning the std::size_t hash of its
+	// argument, for any type it can hash; values that compare equal with ==
+	// hash equal. In order of preference it uses:
+	// * hash_value(t), found by argument-dependent lookup, if it returns a
+	//   std::size_t;
+	// * the value of an integer, enumeration or pointer;
+	// * the value of a float or double, with -0.0 and +0.0 hashed alike;
+	// * the elements of a range of hashable elements, as for hash_range;
+	// * std::hash<T>, if it is enabled.
+	// The result is well mixed in all of its bits, so tables may use its
+	// low or high bits directly.
+	//
+	namespace __hash {
+		// Poison pill: only ADL finds hash_value.
+		template<class T> void hash_value(const T&) = delete;
+
+		struct __fn;
+
+		template<class T>
+		META_CONCEPT has_customization = requires(const T& t) {
+			{ hash_value(t) } -> std::size_t;
+		};
+
+		template<class T>
+		META_CONCEPT is_scalar = std::is_integral_v<T> || std::is_enum_v<T> ||
+			std::is_pointer_v<T> || std::is_null_pointer_v<T>;
+
+		template<class T>
+		META_CONCEPT is_floating = Same<T, float> || Same<T, double>;
+
+		// Some types, like std::filesystem::path, are ranges of
+		// themselves; they are not hashed as ranges.
+		template<class T>
+		META_CONCEPT is_range = InputRange<const T> &&
+			!Same<iter_value_t<iterator_t<const T>>, T> &&
+			requires(iter_reference_t<iterator_t<const T>> e) {
+				std::declval<const __fn&>()(e);
+			};
+
+		template<class T>
+		META_CONCEPT has_std_hash = requires(const T& t) {
+			{ std::hash<T>{}(t) } -> std::size_t;
+		};
+
+		struct __fn {
+			template<class T>
+			requires has_customization<T> || is_scalar<T> || is_floating<T> ||
+				is_range<T> || has_std_hash<T>
+			std::size_t operator()(const T& t) const {
+				std::uint64_t h;
+				if constexpr (has_customization<T>) {
+					h = detail::hash_mix(static_cast<std::size_t>(hash_value(t)));
+				} else if constexpr (std::is_enum_v<T>) {
+					h = detail::hash_mix(static_cast<std::uint64_t>(
+						static_cast<std::underlying_type_t<T>>(t)));
+				} else if constexpr (std::is_pointer_v<T>) {
+					h = detail::hash_mix(reinterpret_cast<std::uintptr_t>(t));
+				} else if constexpr (std::is_null_pointer_v<T>) {
+					h = detail::hash_mix(0);
+				} else if constexpr (is_scalar<T>) {
+					h = detail::hash_mix(static_cast<std::uint64_t>(t));
+				} else if constexpr (is_floating<T>) {
+					double d = t;
+					if (d == 0) d = 0; // -0.0 == +0.0
+					std::uint64_t bits;
+					std::memcpy(&bits, &d, sizeof(bits));
+					h = detail::hash_mix(bits);
+				} else if constexpr (is_range<T>) {
+					h = detail::hash_elements(begin(t), end(t), 0);
+				} else {
+					h = detail::hash_mix(std::hash<T>{}(t));
+				}
+				return static_cast<std::size_t>(h);
+			}
+		};
+	}
+
+	namespace ext {
+		inline constexpr __hash::__fn hash {};
+	}
+
 	///////////////////////////////////////////////////////////////////////////
 	// Hashable [Extension]
-	// Extremely limited since std::hash is not SFINAE-friendly.
 	//
 	namespace ext {
 		template<class T>
 		META_CONCEPT Hashable = requires(const T& e) {
-			typename std::hash<T>;
-			{ std::hash<T>{}(e) } -> std::size_t;
+			{ hash(e) } -> std::size_t;
+		};
+	}
+
+	namespace detail {
+		// ext::hash hashes T by its value, and elements of type T that
+		// compare equal have equal bytes, so they can be hashed as bytes.
+		// A type with a hash_value customization may define equality on
+		// fewer than all of its bytes.
+		template<class T>
+		inline constexpr bool hash_as_bytes = __hash::is_scalar<T> &&
+			!__hash::has_customization<T> &&
+			std::has_unique_object_representations_v<T>;
+
+		template<class I, class S>
+		std::uint64_t hash_elements(I first, S last, std::uint64_t seed) {
+			using V = iter_value_t<I>;
+			if constexpr (ContiguousIterator<I> && SizedSentinel<S, I> &&
+				hash_as_bytes<V>)
+			{
+				const auto n = static_cast<std::size_t>(last - first);
+				return hash_bytes(n ? std::addressof(*first) : nullptr,
+					n * sizeof(V), seed);
+			} else {
+				std::uint64_t n = 0;
+				for (; first != last; ++first, ++n) {
+					seed = hash_combine(seed, ext::hash(*first));
+				}
+				return hash_combine(seed, n);
+			}
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// hash_range [Extension]
+	// Hashes the sequence of elements of a range, at memory bandwidth when
+	// they are contiguous and equal elements have equal bytes. Ranges of the
+	// same type with equal elements hash equal.
+	//
+	namespace ext {
+		struct __hash_range_fn : private __niebloid {
+			template<InputIterator I, Sentinel<I> S>
+			requires Hashable<iter_reference_t<I>>
+			std::size_t operator()(I first, S last, std::size_t seed = 0) const {
+				return static_cast<std::size_t>(
+					detail::hash_elements(std::move(first), std::move(last), seed));
+			}
+
+			template<InputRange R>
+			requires Hashable<iter_reference_t<iterator_t<R>>>
+			std::size_t operator()(R&& r, std::size_t seed = 0) const {
+				return static_cast<std::size_t>(
+					detail::hash_elements(begin(r), end(r), seed));
+			}
 		};
+
+		inline constexpr __hash_range_fn hash_range {};
 	}
 
 	///////////////////////////////////////////////////////////////////////////
 	// hash_combine [Extension]
-	// Stolen from Boost.
+	// Folds the hash of v into seed.
 	//
 	namespace ext {
 		template<Hashable T>
 		inline void hash_combine(std::size_t& seed, const T& v) {
-			std::hash<T> hasher;
-			seed ^= hasher(v) + 0x9e3779b9 + (seed<<6) + (seed>>2);
+			seed = static_cast<std::size_t>(detail::hash_combine(seed, hash(v)));
 		}
 	}
 } STL2_CLOSE_NAMESPACE
@@ -0,0 +1,163 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_SIMD_CONFIG_HPP
+#define STL2_DETAIL_SIMD_CONFIG_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// SIMD kernel configuration
+//
+// Kernels in detail::simd operate on raw pointers to trivial element types.
+// On x86-64 with GCC or Clang they are compiled for SSE2 (the baseline) and
+// AVX2 (via target attributes) and dispatched on the CPU at runtime; the
+// portable fallbacks are plain loops. Define STL2_NO_SIMD to force the
+// fallbacks.
+//
+#ifndef STL2_SIMD_X86
+ #if !defined(STL2_NO_SIMD) && defined(__GNUC__) && defined(__x86_64__)
+  #define STL2_SIMD_X86 1
+ #else
+  #define STL2_SIMD_X86 0
+ #endif
+#endif
+
+#if STL2_SIMD_X86
+ #include <immintrin.h>
+ #define STL2_SIMD_TARGET(...) __attribute__((target(__VA_ARGS__)))
+#endif
+
+STL2_OPEN_NAMESPACE {
+	namespace detail::simd {
+#if STL2_SIMD_X86
+		inline bool has_avx2() noexcept {
+			static const bool result = [] {
+				__builtin_cpu_init();
+				return __builtin_cpu_supports("avx2") != 0;
+			}();
+			return result;
+		}
+
+		// SSE4.2 provides the 128-bit integer minima, maxima, blends and
+		// 64-bit comparisons that SSE2 lacks.
+		inline bool has_sse42() noexcept {
+			static const bool result = [] {
+				__builtin_cpu_init();
+				return __builtin_cpu_supports("sse4.2") != 0;
+			}();
+			return result;
+		}
+
+		// The unsigned integer type with the same width as T.
+		template<class T>
+		using lane_t = meta::if_c<sizeof(T) == 1, std::uint8_t,
+			meta::if_c<sizeof(T) == 2, std::uint16_t,
+			meta::if_c<sizeof(T) == 4, std::uint32_t, std::uint64_t>>>;
+
+		template<class T>
+		lane_t<T> to_lane(const T& t) noexcept {
+			static_assert(sizeof(T) == sizeof(lane_t<T>));
+			lane_t<T> result;
+			std::memcpy(&result, &t, sizeof(T));
+			return result;
+		}
+
+		template<class T>
+		__m128i broadcast128(const T& t) noexcept {
+			const auto u = to_lane(t);
+			if constexpr (sizeof(T) == 1) {
+				return _mm_set1_epi8(static_cast<char>(u));
+			} else if constexpr (sizeof(T) == 2) {
+				return _mm_set1_epi16(static_cast<short>(u));
+			} else if constexpr (sizeof(T) == 4) {
+				return _mm_set1_epi32(static_cast<int>(u));
+			} else {
+				return _mm_set1_epi64x(static_cast<long long>(u));
+			}
+		}
+
+		template<class T>
+		STL2_SIMD_TARGET("avx2")
+		__m256i broadcast256(const T& t) noexcept {
+			const auto u = to_lane(t);
+			if constexpr (sizeof(T) == 1) {
+				return _mm256_set1_epi8(static_cast<char>(u));
+			} else if constexpr (sizeof(T) == 2) {
+				return _mm256_set1_epi16(static_cast<short>(u));
+			} else if constexpr (sizeof(T) == 4) {
+				return _mm256_set1_epi32(static_cast<int>(u));
+			} else {
+				return _mm256_set1_epi64x(static_cast<long long>(u));
+			}
+		}
+
+		// Lanewise equality; each lane of the result is all-ones or all-zeros.
+		template<class T>
+		__m128i cmpeq128(__m128i a, __m128i b) noexcept {
+			if constexpr (sizeof(T) == 1) {
+				return _mm_cmpeq_epi8(a, b);
+			} else if constexpr (sizeof(T) == 2) {
+				return _mm_cmpeq_epi16(a, b);
+			} else if constexpr (sizeof(T) == 4) {
+				return _mm_cmpeq_epi32(a, b);
+			} else {
+				// SSE2 has no 64-bit compare: combine the halves.
+				const __m128i t = _mm_cmpeq_epi32(a, b);
+				return _mm_and_si128(t, _mm_shuffle_epi32(t, _MM_SHUFFLE(2, 3, 0, 1)));
+			}
+		}
+
+		template<class T>
+		STL2_SIMD_TARGET("avx2")
+		__m256i cmpeq256(__m256i a, __m256i b) noexcept {
+			if constexpr (sizeof(T) == 1) {
+				return _mm256_cmpeq_epi8(a, b);
+			} else if constexpr (sizeof(T) == 2) {
+				return _mm256_cmpeq_epi16(a, b);
+			} else if constexpr (sizeof(T) == 4) {
+				return _mm256_cmpeq_epi32(a, b);
+			} else {
+				return _mm256_cmpeq_epi64(a, b);
+			}
+		}
+
+		inline __m128i load128(const void* p) noexcept {
+			return _mm_loadu_si128(static_cast<const __m128i*>(p));
+		}
+
+		STL2_SIMD_TARGET("avx2")
+		inline __m256i load256(const void* p) noexcept {
+			return _mm256_loadu_si256(static_cast<const __m256i*>(p));
+		}
+#endif // STL2_SIMD_X86
+
+		// Hints that the cache line holding p will be read soon. p need
+		// not point to an object.
+		inline void prefetch(const void* p) noexcept {
+#if defined(__GNUC__)
+			__builtin_prefetch(p);
+#else
+			(void)p;
+#endif
+		}
+
+		// Element types the kernels know how to treat as lanes.
+		template<class T>
+		inline constexpr bool is_lane_sized =
+			sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8;
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
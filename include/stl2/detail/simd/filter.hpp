@@ -0,0 +1,186 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_SIMD_FILTER_HPP
+#define STL2_DETAIL_SIMD_FILTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <stl2/detail/simd/config.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// detail::simd::filter
+// (stream compaction kernels for copy_if, remove_if and remove_copy_if
+// over contiguous ranges of arithmetic values compared with a constant)
+//
+// The AVX2 kernels compare a vector of 4- or 8-byte lanes with the
+// constant, then gather the selected lanes to the front of the vector
+// with a permutation looked up by the comparison mask, and store the
+// whole vector: the next store overwrites the lanes that were not
+// selected. Narrower lanes, and CPUs without AVX2, use a scalar loop
+// that stores every element and advances the output by the comparison
+// result, so that it does not branch on it either.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail::simd {
+		// The comparisons x op v of elements x with a constant v that the
+		// kernels evaluate.
+		enum class cmp_op { eq, ne, lt, gt, le, ge };
+
+		template<cmp_op Op, class T>
+		constexpr bool compare_scalar(const T& x, const T& v) noexcept {
+			if constexpr (Op == cmp_op::eq) {
+				return x == v;
+			} else if constexpr (Op == cmp_op::ne) {
+				return x != v;
+			} else if constexpr (Op == cmp_op::lt) {
+				return x < v;
+			} else if constexpr (Op == cmp_op::gt) {
+				return x > v;
+			} else if constexpr (Op == cmp_op::le) {
+				return x <= v;
+			} else {
+				return x >= v;
+			}
+		}
+
+		template<cmp_op Op, bool Keep, class T>
+		std::size_t filter_scalar(const T* in, std::size_t n, T* out, const T& v,
+			std::size_t i, std::size_t k) noexcept
+		{
+			for (; i != n; ++i) {
+				const T x = in[i];
+				out[k] = x;
+				k += compare_scalar<Op>(x, v) == Keep;
+			}
+			return k;
+		}
+
+#if STL2_SIMD_X86
+		// compress_table<W>[m] packs, four bits each, the indices of the
+		// 32-bit lanes that make up the W-byte lanes selected by the bits
+		// of m, in order.
+		template<std::size_t W>
+		struct compress_table {
+			static constexpr std::size_t lanes = 32 / W;
+			std::uint32_t entries[1u << lanes] = {};
+
+			constexpr compress_table() noexcept {
+				for (unsigned m = 0; m < (1u << lanes); ++m) {
+					unsigned nibble = 0;
+					for (unsigned j = 0; j < lanes; ++j) {
+						if (m & (1u << j)) {
+							for (unsigned h = 0; h < W / 4; ++h) {
+								entries[m] |= (j * (W / 4) + h) << (4 * nibble++);
+							}
+						}
+					}
+				}
+			}
+		};
+
+		template<std::size_t W>
+		inline constexpr compress_table<W> compress_indices {};
+
+		// The bits of the result select the lanes of x that satisfy
+		// x Op v == Keep.
+		template<cmp_op Op, bool Keep, class T>
+		STL2_SIMD_TARGET("avx2")
+		unsigned select256(__m256i x, __m256i v) noexcept {
+			constexpr unsigned all = sizeof(T) == 4 ? 0xff : 0xf;
+			unsigned mask;
+			if constexpr (std::is_floating_point_v<T>) {
+				constexpr int imm =
+					Op == cmp_op::eq ? _CMP_EQ_OQ :
+					Op == cmp_op::ne ? _CMP_NEQ_UQ :
+					Op == cmp_op::lt ? _CMP_LT_OQ :
+					Op == cmp_op::gt ? _CMP_GT_OQ :
+					Op == cmp_op::le ? _CMP_LE_OQ : _CMP_GE_OQ;
+				if constexpr (sizeof(T) == 4) {
+					mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(
+						_mm256_castsi256_ps(x), _mm256_castsi256_ps(v), imm)));
+				} else {
+					mask = static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(
+						_mm256_castsi256_pd(x), _mm256_castsi256_pd(v), imm)));
+				}
+			} else {
+				// The integer comparisons are ==, > and their negations;
+				// v has had its sign bit flipped already if T is unsigned.
+				if constexpr (std::is_unsigned_v<T>) {
+					x = _mm256_xor_si256(x, broadcast256(T(1) << (8 * sizeof(T) - 1)));
+				}
+				__m256i c;
+				if constexpr (Op == cmp_op::eq || Op == cmp_op::ne) {
+					c = sizeof(T) == 4 ? _mm256_cmpeq_epi32(x, v) : _mm256_cmpeq_epi64(x, v);
+				} else if constexpr (Op == cmp_op::gt || Op == cmp_op::le) {
+					c = sizeof(T) == 4 ? _mm256_cmpgt_epi32(x, v) : _mm256_cmpgt_epi64(x, v);
+				} else {
+					c = sizeof(T) == 4 ? _mm256_cmpgt_epi32(v, x) : _mm256_cmpgt_epi64(v, x);
+				}
+				if constexpr (sizeof(T) == 4) {
+					mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(c)));
+				} else {
+					mask = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(c)));
+				}
+				if constexpr (Op == cmp_op::ne || Op == cmp_op::le || Op == cmp_op::ge) {
+					mask ^= all;
+				}
+			}
+			if constexpr (!Keep) {
+				mask ^= all;
+			}
+			return mask;
+		}
+
+		template<cmp_op Op, bool Keep, class T>
+		STL2_SIMD_TARGET("avx2")
+		std::size_t filter_avx2(const T* in, std::size_t n, T* out, const T& v) noexcept {
+			constexpr std::size_t lanes = 32 / sizeof(T);
+			std::size_t i = 0, k = 0;
+			if constexpr (sizeof(T) >= 4) {
+				auto vv = broadcast256(v);
+				if constexpr (std::is_unsigned_v<T>) {
+					vv = _mm256_xor_si256(vv, broadcast256(T(1) << (8 * sizeof(T) - 1)));
+				}
+				const __m256i shifts = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+				const __m256i nibble = _mm256_set1_epi32(0xf);
+				for (; n - i >= lanes; i += lanes) {
+					const __m256i x = load256(in + i);
+					const unsigned mask = select256<Op, Keep, T>(x, vv);
+					const __m256i indices = _mm256_and_si256(nibble, _mm256_srlv_epi32(
+						_mm256_set1_epi32(static_cast<int>(
+							compress_indices<sizeof(T)>.entries[mask])), shifts));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k),
+						_mm256_permutevar8x32_epi32(x, indices));
+					k += static_cast<std::size_t>(__builtin_popcount(mask));
+				}
+			}
+			return filter_scalar<Op, Keep>(in, n, out, v, i, k);
+		}
+#endif // STL2_SIMD_X86
+
+		// Copies, in order, the elements x of the n at in for which
+		// (x Op v) == Keep to out, and returns how many there are. Any of
+		// the n elements at out may be written, and out may equal in.
+		template<cmp_op Op, bool Keep, class T>
+		std::size_t filter(const T* in, std::size_t n, T* out, const T& v) noexcept {
+#if STL2_SIMD_X86
+			if constexpr (sizeof(T) >= 4) {
+				if (has_avx2()) return filter_avx2<Op, Keep>(in, n, out, v);
+			}
+#endif // STL2_SIMD_X86
+			return filter_scalar<Op, Keep>(in, n, out, v, 0, 0);
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,132 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_SIMD_FIND_HPP
+#define STL2_DETAIL_SIMD_FIND_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <stl2/detail/simd/config.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// detail::simd::find_eq and detail::simd::count_eq
+// (kernels for find and count over contiguous ranges of integers)
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail::simd {
+		template<class T>
+		const T* find_eq_scalar(const T* first, const T* last, const T& value) noexcept {
+			for (; first != last; ++first) {
+				if (*first == value) break;
+			}
+			return first;
+		}
+
+		template<class T>
+		std::ptrdiff_t count_eq_scalar(const T* first, const T* last, const T& value) noexcept {
+			std::ptrdiff_t n = 0;
+			for (; first != last; ++first) {
+				n += *first == value;
+			}
+			return n;
+		}
+
+#if STL2_SIMD_X86
+		template<class T>
+		const T* find_eq_sse2(const T* first, const T* last, const T& value) noexcept {
+			constexpr std::ptrdiff_t lanes = 16 / sizeof(T);
+			const __m128i needle = broadcast128(value);
+			for (; last - first >= lanes; first += lanes) {
+				const auto mask = static_cast<unsigned>(
+					_mm_movemask_epi8(cmpeq128<T>(load128(first), needle)));
+				if (mask) return first + __builtin_ctz(mask) / sizeof(T);
+			}
+			return find_eq_scalar(first, last, value);
+		}
+
+		template<class T>
+		STL2_SIMD_TARGET("avx2")
+		const T* find_eq_avx2(const T* first, const T* last, const T& value) noexcept {
+			constexpr std::ptrdiff_t lanes = 32 / sizeof(T);
+			const __m256i needle = broadcast256(value);
+			for (; last - first >= lanes; first += lanes) {
+				const auto mask = static_cast<unsigned>(
+					_mm256_movemask_epi8(cmpeq256<T>(load256(first), needle)));
+				if (mask) return first + __builtin_ctz(mask) / sizeof(T);
+			}
+			return find_eq_scalar(first, last, value);
+		}
+
+		// Each matching lane contributes sizeof(T) bits to the movemasks.
+		template<class T>
+		std::ptrdiff_t count_eq_sse2(const T* first, const T* last, const T& value) noexcept {
+			constexpr std::ptrdiff_t lanes = 16 / sizeof(T);
+			const __m128i needle = broadcast128(value);
+			std::ptrdiff_t bits = 0;
+			for (; last - first >= lanes; first += lanes) {
+				bits += __builtin_popcount(static_cast<unsigned>(
+					_mm_movemask_epi8(cmpeq128<T>(load128(first), needle))));
+			}
+			return bits / std::ptrdiff_t(sizeof(T)) + count_eq_scalar(first, last, value);
+		}
+
+		template<class T>
+		STL2_SIMD_TARGET("avx2")
+		std::ptrdiff_t count_eq_avx2(const T* first, const T* last, const T& value) noexcept {
+			constexpr std::ptrdiff_t lanes = 32 / sizeof(T);
+			const __m256i needle = broadcast256(value);
+			std::ptrdiff_t bits = 0;
+			for (; last - first >= lanes; first += lanes) {
+				bits += __builtin_popcount(static_cast<unsigned>(
+					_mm256_movemask_epi8(cmpeq256<T>(load256(first), needle))));
+			}
+			return bits / std::ptrdiff_t(sizeof(T)) + count_eq_scalar(first, last, value);
+		}
+#endif // STL2_SIMD_X86
+
+		// Returns a pointer to the first element of [first, last) whose
+		// representation equals that of value, or last if there is none.
+		template<class T>
+		const T* find_eq(const T* first, const T* last, const T& value) noexcept {
+			if constexpr (sizeof(T) == 1) {
+				unsigned char byte;
+				std::memcpy(&byte, &value, 1);
+				auto p = std::memchr(first, byte, static_cast<std::size_t>(last - first));
+				return p ? static_cast<const T*>(p) : last;
+			} else {
+#if STL2_SIMD_X86
+				if constexpr (is_lane_sized<T>) {
+					return has_avx2()
+						? find_eq_avx2(first, last, value)
+						: find_eq_sse2(first, last, value);
+				}
+#endif // STL2_SIMD_X86
+				return find_eq_scalar(first, last, value);
+			}
+		}
+
+		// Returns the number of elements of [first, last) whose
+		// representation equals that of value.
+		template<class T>
+		std::ptrdiff_t count_eq(const T* first, const T* last, const T& value) noexcept {
+#if STL2_SIMD_X86
+			if constexpr (is_lane_sized<T>) {
+				return has_avx2()
+					? count_eq_avx2(first, last, value)
+					: count_eq_sse2(first, last, value);
+			}
+#endif // STL2_SIMD_X86
+			return count_eq_scalar(first, last, value);
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
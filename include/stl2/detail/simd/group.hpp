@@ -0,0 +1,54 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_SIMD_GROUP_HPP
+#define STL2_DETAIL_SIMD_GROUP_HPP
+
+#include <stl2/detail/simd/config.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// detail::simd::match_eq16 and detail::simd::match_lt16
+// (matching a group of 16 control bytes of an open-addressing hash table)
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail::simd {
+		// Bit i of the result is set iff byte i of the 16 at p equals b.
+		inline unsigned match_eq16(const signed char* p, signed char b) noexcept {
+#if STL2_SIMD_X86
+			return static_cast<unsigned>(_mm_movemask_epi8(
+				_mm_cmpeq_epi8(load128(p), _mm_set1_epi8(b))));
+#else
+			unsigned mask = 0;
+			for (int i = 0; i < 16; ++i) {
+				mask |= unsigned{p[i] == b} << i;
+			}
+			return mask;
+#endif // STL2_SIMD_X86
+		}
+
+		// Bit i of the result is set iff byte i of the 16 at p is less
+		// than b.
+		inline unsigned match_lt16(const signed char* p, signed char b) noexcept {
+#if STL2_SIMD_X86
+			return static_cast<unsigned>(_mm_movemask_epi8(
+				_mm_cmpgt_epi8(_mm_set1_epi8(b), load128(p))));
+#else
+			unsigned mask = 0;
+			for (int i = 0; i < 16; ++i) {
+				mask |= unsigned{p[i] < b} << i;
+			}
+			return mask;
+#endif // STL2_SIMD_X86
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
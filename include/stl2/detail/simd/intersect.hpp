@@ -0,0 +1,237 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_SIMD_INTERSECT_HPP
+#define STL2_DETAIL_SIMD_INTERSECT_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <stl2/detail/simd/config.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// detail::simd::intersect and detail::simd::includes
+// (kernels for set_intersection and includes over contiguous ranges of
+// integers sorted by <)
+//
+// When one range is much longer than the other, each element of the
+// shorter is found in the longer by galloping: an exponential search
+// from the previous match, which costs O(log gap) rather than O(gap).
+// When the lengths are similar and neither range repeats a value, blocks
+// of four elements from each are compared all against all, after
+// Lemire, Boytsov and Kurz, "SIMD Compression and the Intersection of
+// Sorted Integers" (2016): the block with the lesser maximum is then
+// consumed, without branching on the elements. Otherwise the elements
+// are merged one at a time.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail::simd {
+		// The longer range is galloped through once it is this many times
+		// longer than the shorter.
+		inline constexpr std::size_t gallop_ratio = 32;
+
+		// Returns the least k in [lo, n) with !(p[k] < v), or n, searching
+		// in steps that double from lo.
+		template<class T>
+		std::size_t gallop_lower_bound(const T* p, std::size_t lo, std::size_t n,
+			const T& v) noexcept
+		{
+			std::size_t hi = lo, step = 1;
+			while (hi < n && p[hi] < v) {
+				lo = hi + 1;
+				hi += step;
+				step *= 2;
+			}
+			if (hi > n) hi = n;
+			while (lo < hi) {
+				const std::size_t mid = lo + (hi - lo) / 2;
+				if (p[mid] < v) {
+					lo = mid + 1;
+				} else {
+					hi = mid;
+				}
+			}
+			return lo;
+		}
+
+		template<class T>
+		bool strictly_increasing(const T* p, std::size_t n) noexcept {
+			bool result = true;
+			for (std::size_t k = 1; k < n; ++k) {
+				result &= p[k - 1] < p[k];
+			}
+			return result;
+		}
+
+		// Merges a[i, na) with b[j, nb) one element at a time until either
+		// is exhausted, passing the index in a of each common element to
+		// emit.
+		template<class T, class F>
+		void intersect_scalar(const T* a, std::size_t na, const T* b, std::size_t nb,
+			std::size_t& i, std::size_t& j, F& emit)
+		{
+			while (i != na && j != nb) {
+				if (a[i] < b[j]) {
+					++i;
+				} else if (b[j] < a[i]) {
+					++j;
+				} else {
+					emit(i);
+					++i;
+					++j;
+				}
+			}
+		}
+
+		// Finds each element of small in large, passing the index of each
+		// found to emit(s, l); both positions end where a merge would leave
+		// them.
+		template<class T, class F>
+		void intersect_gallop(const T* small, std::size_t ns, std::size_t& s,
+			const T* large, std::size_t nl, std::size_t& l, F& emit)
+		{
+			for (; s != ns; ++s) {
+				l = gallop_lower_bound(large, l, nl, small[s]);
+				if (l == nl) break;
+				if (!(small[s] < large[l])) {
+					emit(s, l);
+					++l;
+				}
+			}
+		}
+
+#if STL2_SIMD_X86
+		// Each kernel compares a block of a with the rotations of a block of
+		// b, passes the indices of the elements of a's block found in b's to
+		// emit, and consumes the block with the lesser maximum, or both.
+		// Ranges with no repeated values are required: a value of a's block
+		// is then found at most once, and never again after its block of b
+		// is consumed.
+		template<class T, class F>
+		void intersect_sse2(const T* a, std::size_t na, const T* b, std::size_t nb,
+			std::size_t& i, std::size_t& j, F& emit)
+		{
+			static_assert(sizeof(T) == 4);
+			while (na - i >= 4 && nb - j >= 4) {
+				const __m128i x = load128(a + i);
+				const __m128i y = load128(b + j);
+				__m128i m = _mm_cmpeq_epi32(x, y);
+				m = _mm_or_si128(m, _mm_cmpeq_epi32(x, _mm_shuffle_epi32(y, _MM_SHUFFLE(0, 3, 2, 1))));
+				m = _mm_or_si128(m, _mm_cmpeq_epi32(x, _mm_shuffle_epi32(y, _MM_SHUFFLE(1, 0, 3, 2))));
+				m = _mm_or_si128(m, _mm_cmpeq_epi32(x, _mm_shuffle_epi32(y, _MM_SHUFFLE(2, 1, 0, 3))));
+				for (auto mask = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(m)));
+					mask; mask &= mask - 1)
+				{
+					emit(i + static_cast<std::size_t>(__builtin_ctz(mask)));
+				}
+				const T amax = a[i + 3], bmax = b[j + 3];
+				i += std::size_t{!(bmax < amax)} * 4;
+				j += std::size_t{!(amax < bmax)} * 4;
+			}
+		}
+
+		template<class T, class F>
+		STL2_SIMD_TARGET("avx2")
+		void intersect_avx2(const T* a, std::size_t na, const T* b, std::size_t nb,
+			std::size_t& i, std::size_t& j, F& emit)
+		{
+			static_assert(sizeof(T) == 8);
+			while (na - i >= 4 && nb - j >= 4) {
+				const __m256i x = load256(a + i);
+				const __m256i y = load256(b + j);
+				__m256i m = _mm256_cmpeq_epi64(x, y);
+				m = _mm256_or_si256(m, _mm256_cmpeq_epi64(x, _mm256_permute4x64_epi64(y, _MM_SHUFFLE(0, 3, 2, 1))));
+				m = _mm256_or_si256(m, _mm256_cmpeq_epi64(x, _mm256_permute4x64_epi64(y, _MM_SHUFFLE(1, 0, 3, 2))));
+				m = _mm256_or_si256(m, _mm256_cmpeq_epi64(x, _mm256_permute4x64_epi64(y, _MM_SHUFFLE(2, 1, 0, 3))));
+				for (auto mask = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(m)));
+					mask; mask &= mask - 1)
+				{
+					emit(i + static_cast<std::size_t>(__builtin_ctz(mask)));
+				}
+				const T amax = a[i + 3], bmax = b[j + 3];
+				i += std::size_t{!(bmax < amax)} * 4;
+				j += std::size_t{!(amax < bmax)} * 4;
+			}
+		}
+#endif // STL2_SIMD_X86
+
+		// Passes the indices in a of the elements common to the sorted
+		// ranges [a, a + na) and [b, b + nb) to emit in order, as
+		// set_intersection would copy them, and sets i and j to where
+		// set_intersection would stop in each.
+		template<class T, class F>
+		void intersect(const T* a, std::size_t na, const T* b, std::size_t nb,
+			std::size_t& i, std::size_t& j, F& emit)
+		{
+			static_assert(std::is_integral_v<T>);
+			i = j = 0;
+			if (na / gallop_ratio >= nb) {
+				auto found = [&emit](std::size_t, std::size_t k) { emit(k); };
+				intersect_gallop(b, nb, j, a, na, i, found);
+				return;
+			}
+			if (nb / gallop_ratio >= na) {
+				auto found = [&emit](std::size_t k, std::size_t) { emit(k); };
+				intersect_gallop(a, na, i, b, nb, j, found);
+				return;
+			}
+#if STL2_SIMD_X86
+			if constexpr (sizeof(T) == 4 || sizeof(T) == 8) {
+				if ((sizeof(T) == 4 || has_avx2()) &&
+					strictly_increasing(a, na) && strictly_increasing(b, nb))
+				{
+					if constexpr (sizeof(T) == 4) {
+						intersect_sse2(a, na, b, nb, i, j, emit);
+					} else {
+						intersect_avx2(a, na, b, nb, i, j, emit);
+					}
+					// The blocks consumed may leave unconsumed elements of the
+					// other range that are less than some already consumed, which
+					// the merge skips; but once a range is exhausted a merge would
+					// also have consumed those of the other, and any equal to its
+					// last element.
+					intersect_scalar(a, na, b, nb, i, j, emit);
+					if (i == na && na != 0 && j != nb) {
+						j = gallop_lower_bound(b, j, nb, a[na - 1]);
+						if (j != nb && !(a[na - 1] < b[j])) ++j;
+					} else if (j == nb && nb != 0 && i != na) {
+						i = gallop_lower_bound(a, i, na, b[nb - 1]);
+						if (i != na && !(b[nb - 1] < a[i])) ++i;
+					}
+					return;
+				}
+			}
+#endif // STL2_SIMD_X86
+			intersect_scalar(a, na, b, nb, i, j, emit);
+		}
+
+		// Returns true iff the sorted range [b, b + nb) is a sub-multiset of
+		// the sorted range [a, a + na).
+		template<class T>
+		bool includes(const T* a, std::size_t na, const T* b, std::size_t nb) noexcept {
+			static_assert(std::is_integral_v<T>);
+			if (nb > na) return false;
+			if (na / gallop_ratio >= nb) {
+				std::size_t i = 0;
+				for (std::size_t j = 0; j != nb; ++j, ++i) {
+					i = gallop_lower_bound(a, i, na, b[j]);
+					if (i == na || b[j] < a[i]) return false;
+				}
+				return true;
+			}
+			std::size_t count = 0, i = 0, j = 0;
+			auto counter = [&count](std::size_t) noexcept { ++count; };
+			intersect(a, na, b, nb, i, j, counter);
+			return count == nb;
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,469 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_SIMD_MINMAX_HPP
+#define STL2_DETAIL_SIMD_MINMAX_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <stl2/detail/simd/config.hpp>
+#include <stl2/detail/simd/find.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// detail::simd::find_extrema, detail::simd::find_value and
+// detail::simd::rfind_value
+// (kernels for min_element, max_element and minmax_element over contiguous
+// ranges of integers and floating-point numbers)
+//
+// The algorithms first reduce the range to its least and greatest values,
+// then search for the position of the one they want; doing it in two
+// passes keeps the reductions to lanewise minima and maxima, and lets the
+// searches choose the first or last of equal elements exactly as the
+// sequential algorithms do.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail::simd {
+		template<class T>
+		struct extrema {
+			T min;
+			T max;
+		};
+
+		template<class T>
+		extrema<T> extrema_scalar(const T* first, const T* last, extrema<T> e) noexcept {
+			for (; first != last; ++first) {
+				if (*first < e.min) e.min = *first;
+				if (e.max < *first) e.max = *first;
+			}
+			return e;
+		}
+
+		template<class T>
+		bool has_nan_scalar(const T* first, const T* last) noexcept {
+			for (; first != last; ++first) {
+				if (*first != *first) return true;
+			}
+			return false;
+		}
+
+		template<class T>
+		const T* rfind_value_scalar(const T* first, const T* last, const T& value) noexcept {
+			for (auto i = last; i != first;) {
+				if (*--i == value) return i;
+			}
+			return last;
+		}
+
+		template<class T>
+		const T* find_value_scalar(const T* first, const T* last, const T& value) noexcept {
+			for (; first != last; ++first) {
+				if (*first == value) break;
+			}
+			return first;
+		}
+
+#if STL2_SIMD_X86
+		// Lanewise minima and maxima of integers. There are no 64-bit
+		// instructions for them before AVX-512; compare and blend instead,
+		// flipping the sign bits to compare unsigned lanes.
+		template<class T>
+		STL2_SIMD_TARGET("sse4.2")
+		__m128i gt128(__m128i a, __m128i b) noexcept {
+			static_assert(sizeof(T) == 8);
+			if constexpr (std::is_signed_v<T>) {
+				return _mm_cmpgt_epi64(a, b);
+			} else {
+				const __m128i flip = _mm_set1_epi64x(static_cast<long long>(1ull << 63));
+				return _mm_cmpgt_epi64(_mm_xor_si128(a, flip), _mm_xor_si128(b, flip));
+			}
+		}
+
+		template<class T>
+		STL2_SIMD_TARGET("sse4.2")
+		__m128i min128(__m128i a, __m128i b) noexcept {
+			constexpr bool is_signed = std::is_signed_v<T>;
+			if constexpr (sizeof(T) == 1) {
+				return is_signed ? _mm_min_epi8(a, b) : _mm_min_epu8(a, b);
+			} else if constexpr (sizeof(T) == 2) {
+				return is_signed ? _mm_min_epi16(a, b) : _mm_min_epu16(a, b);
+			} else if constexpr (sizeof(T) == 4) {
+				return is_signed ? _mm_min_epi32(a, b) : _mm_min_epu32(a, b);
+			} else {
+				return _mm_blendv_epi8(a, b, gt128<T>(a, b));
+			}
+		}
+
+		template<class T>
+		STL2_SIMD_TARGET("sse4.2")
+		__m128i max128(__m128i a, __m128i b) noexcept {
+			constexpr bool is_signed = std::is_signed_v<T>;
+			if constexpr (sizeof(T) == 1) {
+				return is_signed ? _mm_max_epi8(a, b) : _mm_max_epu8(a, b);
+			} else if constexpr (sizeof(T) == 2) {
+				return is_signed ? _mm_max_epi16(a, b) : _mm_max_epu16(a, b);
+			} else if constexpr (sizeof(T) == 4) {
+				return is_signed ? _mm_max_epi32(a, b) : _mm_max_epu32(a, b);
+			} else {
+				return _mm_blendv_epi8(b, a, gt128<T>(a, b));
+			}
+		}
+
+		template<class T>
+		STL2_SIMD_TARGET("avx2")
+		__m256i gt256(__m256i a, __m256i b) noexcept {
+			static_assert(sizeof(T) == 8);
+			if constexpr (std::is_signed_v<T>) {
+				return _mm256_cmpgt_epi64(a, b);
+			} else {
+				const __m256i flip = _mm256_set1_epi64x(static_cast<long long>(1ull << 63));
+				return _mm256_cmpgt_epi64(_mm256_xor_si256(a, flip), _mm256_xor_si256(b, flip));
+			}
+		}
+
+		template<class T>
+		STL2_SIMD_TARGET("avx2")
+		__m256i min256(__m256i a, __m256i b) noexcept {
+			constexpr bool is_signed = std::is_signed_v<T>;
+			if constexpr (sizeof(T) == 1) {
+				return is_signed ? _mm256_min_epi8(a, b) : _mm256_min_epu8(a, b);
+			} else if constexpr (sizeof(T) == 2) {
+				return is_signed ? _mm256_min_epi16(a, b) : _mm256_min_epu16(a, b);
+			} else if constexpr (sizeof(T) == 4) {
+				return is_signed ? _mm256_min_epi32(a, b) : _mm256_min_epu32(a, b);
+			} else {
+				return _mm256_blendv_epi8(a, b, gt256<T>(a, b));
+			}
+		}
+
+		template<class T>
+		STL2_SIMD_TARGET("avx2")
+		__m256i max256(__m256i a, __m256i b) noexcept {
+			constexpr bool is_signed = std::is_signed_v<T>;
+			if constexpr (sizeof(T) == 1) {
+				return is_signed ? _mm256_max_epi8(a, b) : _mm256_max_epu8(a, b);
+			} else if constexpr (sizeof(T) == 2) {
+				return is_signed ? _mm256_max_epi16(a, b) : _mm256_max_epu16(a, b);
+			} else if constexpr (sizeof(T) == 4) {
+				return is_signed ? _mm256_max_epi32(a, b) : _mm256_max_epu32(a, b);
+			} else {
+				return _mm256_blendv_epi8(b, a, gt256<T>(a, b));
+			}
+		}
+
+		// Each kernel reduces whole vectors lanewise, then the lanes and
+		// the tail of the range with extrema_scalar.
+		template<class T>
+		STL2_SIMD_TARGET("sse4.2")
+		extrema<T> extrema_int_sse42(const T* first, const T* last) noexcept {
+			constexpr std::ptrdiff_t lanes = 16 / sizeof(T);
+			extrema<T> e{*first, *first};
+			if (last - first >= lanes) {
+				__m128i lo = load128(first);
+				__m128i hi = lo;
+				for (first += lanes; last - first >= lanes; first += lanes) {
+					const __m128i x = load128(first);
+					lo = min128<T>(lo, x);
+					hi = max128<T>(hi, x);
+				}
+				alignas(16) T l[lanes];
+				alignas(16) T h[lanes];
+				_mm_store_si128(reinterpret_cast<__m128i*>(l), lo);
+				_mm_store_si128(reinterpret_cast<__m128i*>(h), hi);
+				e.min = extrema_scalar(l, l + lanes, e).min;
+				e.max = extrema_scalar(h, h + lanes, e).max;
+			}
+			return extrema_scalar(first, last, e);
+		}
+
+		template<class T>
+		STL2_SIMD_TARGET("avx2")
+		extrema<T> extrema_int_avx2(const T* first, const T* last) noexcept {
+			constexpr std::ptrdiff_t lanes = 32 / sizeof(T);
+			extrema<T> e{*first, *first};
+			if (last - first >= lanes) {
+				__m256i lo = load256(first);
+				__m256i hi = lo;
+				for (first += lanes; last - first >= lanes; first += lanes) {
+					const __m256i x = load256(first);
+					lo = min256<T>(lo, x);
+					hi = max256<T>(hi, x);
+				}
+				alignas(32) T l[lanes];
+				alignas(32) T h[lanes];
+				_mm256_store_si256(reinterpret_cast<__m256i*>(l), lo);
+				_mm256_store_si256(reinterpret_cast<__m256i*>(h), hi);
+				e.min = extrema_scalar(l, l + lanes, e).min;
+				e.max = extrema_scalar(h, h + lanes, e).max;
+			}
+			return extrema_scalar(first, last, e);
+		}
+
+		// Floating-point kernels also accumulate a mask of unordered
+		// lanes, and report whether the range holds a NaN.
+		template<class T>
+		bool extrema_fp_sse2(const T* first, const T* last, extrema<T>& e) noexcept {
+			static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>);
+			constexpr std::ptrdiff_t lanes = 16 / sizeof(T);
+			e = {*first, *first};
+			if (last - first >= lanes) {
+				alignas(16) T l[lanes];
+				alignas(16) T h[lanes];
+				int nan;
+				if constexpr (sizeof(T) == 4) {
+					__m128 lo = _mm_loadu_ps(first);
+					__m128 hi = lo;
+					__m128 unord = _mm_cmpunord_ps(lo, lo);
+					for (first += lanes; last - first >= lanes; first += lanes) {
+						const __m128 x = _mm_loadu_ps(first);
+						unord = _mm_or_ps(unord, _mm_cmpunord_ps(x, x));
+						lo = _mm_min_ps(lo, x);
+						hi = _mm_max_ps(hi, x);
+					}
+					nan = _mm_movemask_ps(unord);
+					_mm_store_ps(l, lo);
+					_mm_store_ps(h, hi);
+				} else {
+					__m128d lo = _mm_loadu_pd(first);
+					__m128d hi = lo;
+					__m128d unord = _mm_cmpunord_pd(lo, lo);
+					for (first += lanes; last - first >= lanes; first += lanes) {
+						const __m128d x = _mm_loadu_pd(first);
+						unord = _mm_or_pd(unord, _mm_cmpunord_pd(x, x));
+						lo = _mm_min_pd(lo, x);
+						hi = _mm_max_pd(hi, x);
+					}
+					nan = _mm_movemask_pd(unord);
+					_mm_store_pd(l, lo);
+					_mm_store_pd(h, hi);
+				}
+				if (nan) return false;
+				e.min = extrema_scalar(l, l + lanes, e).min;
+				e.max = extrema_scalar(h, h + lanes, e).max;
+			}
+			if (has_nan_scalar(first, last)) return false;
+			e = extrema_scalar(first, last, e);
+			return true;
+		}
+
+		template<class T>
+		STL2_SIMD_TARGET("avx2")
+		bool extrema_fp_avx2(const T* first, const T* last, extrema<T>& e) noexcept {
+			static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>);
+			constexpr std::ptrdiff_t lanes = 32 / sizeof(T);
+			e = {*first, *first};
+			if (last - first >= lanes) {
+				alignas(32) T l[lanes];
+				alignas(32) T h[lanes];
+				int nan;
+				if constexpr (sizeof(T) == 4) {
+					__m256 lo = _mm256_loadu_ps(first);
+					__m256 hi = lo;
+					__m256 unord = _mm256_cmp_ps(lo, lo, _CMP_UNORD_Q);
+					for (first += lanes; last - first >= lanes; first += lanes) {
+						const __m256 x = _mm256_loadu_ps(first);
+						unord = _mm256_or_ps(unord, _mm256_cmp_ps(x, x, _CMP_UNORD_Q));
+						lo = _mm256_min_ps(lo, x);
+						hi = _mm256_max_ps(hi, x);
+					}
+					nan = _mm256_movemask_ps(unord);
+					_mm256_store_ps(l, lo);
+					_mm256_store_ps(h, hi);
+				} else {
+					__m256d lo = _mm256_loadu_pd(first);
+					__m256d hi = lo;
+					__m256d unord = _mm256_cmp_pd(lo, lo, _CMP_UNORD_Q);
+					for (first += lanes; last - first >= lanes; first += lanes) {
+						const __m256d x = _mm256_loadu_pd(first);
+						unord = _mm256_or_pd(unord, _mm256_cmp_pd(x, x, _CMP_UNORD_Q));
+						lo = _mm256_min_pd(lo, x);
+						hi = _mm256_max_pd(hi, x);
+					}
+					nan = _mm256_movemask_pd(unord);
+					_mm256_store_pd(l, lo);
+					_mm256_store_pd(h, hi);
+				}
+				if (nan) return false;
+				e.min = extrema_scalar(l, l + lanes, e).min;
+				e.max = extrema_scalar(h, h + lanes, e).max;
+			}
+			if (has_nan_scalar(first, last)) return false;
+			e = extrema_scalar(first, last, e);
+			return true;
+		}
+
+		// Searches compare floating-point lanes as numbers, so that -0.0
+		// and +0.0 are equal as they are to min_element.
+		template<class T>
+		const T* find_fp_sse2(const T* first, const T* last, const T& value) noexcept {
+			constexpr std::ptrdiff_t lanes = 16 / sizeof(T);
+			for (; last - first >= lanes; first += lanes) {
+				unsigned mask;
+				if constexpr (sizeof(T) == 4) {
+					mask = static_cast<unsigned>(_mm_movemask_ps(
+						_mm_cmpeq_ps(_mm_loadu_ps(first), _mm_set1_ps(value))));
+				} else {
+					mask = static_cast<unsigned>(_mm_movemask_pd(
+						_mm_cmpeq_pd(_mm_loadu_pd(first), _mm_set1_pd(value))));
+				}
+				if (mask) return first + __builtin_ctz(mask);
+			}
+			return find_value_scalar(first, last, value);
+		}
+
+		template<class T>
+		STL2_SIMD_TARGET("avx2")
+		const T* find_fp_avx2(const T* first, const T* last, const T& value) noexcept {
+			constexpr std::ptrdiff_t lanes = 32 / sizeof(T);
+			for (; last - first >= lanes; first += lanes) {
+				unsigned mask;
+				if constexpr (sizeof(T) == 4) {
+					mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(
+						_mm256_loadu_ps(first), _mm256_set1_ps(value), _CMP_EQ_OQ)));
+				} else {
+					mask = static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(
+						_mm256_loadu_pd(first), _mm256_set1_pd(value), _CMP_EQ_OQ)));
+				}
+				if (mask) return first + __builtin_ctz(mask);
+			}
+			return find_value_scalar(first, last, value);
+		}
+
+		// Backward searches return the highest matching lane of the last
+		// vector that has one: 31 - clz of the mask is its highest bit.
+		template<class T>
+		const T* rfind_sse2(const T* first, const T* last, const T& value) noexcept {
+			constexpr std::ptrdiff_t lanes = 16 / sizeof(T);
+			for (auto i = last; i - first >= lanes;) {
+				i -= lanes;
+				unsigned mask;
+				if constexpr (std::is_floating_point_v<T>) {
+					if constexpr (sizeof(T) == 4) {
+						mask = static_cast<unsigned>(_mm_movemask_ps(
+							_mm_cmpeq_ps(_mm_loadu_ps(i), _mm_set1_ps(value))));
+					} else {
+						mask = static_cast<unsigned>(_mm_movemask_pd(
+							_mm_cmpeq_pd(_mm_loadu_pd(i), _mm_set1_pd(value))));
+					}
+					if (mask) return i + (31 - __builtin_clz(mask));
+				} else {
+					mask = static_cast<unsigned>(_mm_movemask_epi8(
+						cmpeq128<T>(load128(i), broadcast128(value))));
+					if (mask) return i + (31 - __builtin_clz(mask)) / sizeof(T);
+				}
+			}
+			const auto tail = first + (last - first) % lanes;
+			const auto i = rfind_value_scalar(first, tail, value);
+			return i != tail ? i : last;
+		}
+
+		template<class T>
+		STL2_SIMD_TARGET("avx2")
+		const T* rfind_avx2(const T* first, const T* last, const T& value) noexcept {
+			constexpr std::ptrdiff_t lanes = 32 / sizeof(T);
+			for (auto i = last; i - first >= lanes;) {
+				i -= lanes;
+				unsigned mask;
+				if constexpr (std::is_floating_point_v<T>) {
+					if constexpr (sizeof(T) == 4) {
+						mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(
+							_mm256_loadu_ps(i), _mm256_set1_ps(value), _CMP_EQ_OQ)));
+					} else {
+						mask = static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(
+							_mm256_loadu_pd(i), _mm256_set1_pd(value), _CMP_EQ_OQ)));
+					}
+					if (mask) return i + (31 - __builtin_clz(mask));
+				} else {
+					mask = static_cast<unsigned>(_mm256_movemask_epi8(
+						cmpeq256<T>(load256(i), broadcast256(value))));
+					if (mask) return i + (31 - __builtin_clz(mask)) / sizeof(T);
+				}
+			}
+			const auto tail = first + (last - first) % lanes;
+			const auto i = rfind_value_scalar(first, tail, value);
+			return i != tail ? i : last;
+		}
+#endif // STL2_SIMD_X86
+
+		// Element types the kernels below accept: integers other than bool,
+		// float and double.
+		template<class T>
+		inline constexpr bool is_orderable_lane =
+			(std::is_integral_v<T> && !std::is_same_v<T, bool> && is_lane_sized<T>) ||
+			std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+		// Stores the least and greatest values of the non-empty range
+		// [first, last) to e. Returns false, leaving e unspecified, if the
+		// range holds a NaN: < does not order such a range, and the
+		// algorithms must then do exactly what their sequential
+		// definitions do.
+		template<class T>
+		bool find_extrema(const T* first, const T* last, extrema<T>& e) noexcept {
+			static_assert(is_orderable_lane<T>);
+			if constexpr (std::is_floating_point_v<T>) {
+#if STL2_SIMD_X86
+				if (has_avx2()) return extrema_fp_avx2(first, last, e);
+				return extrema_fp_sse2(first, last, e);
+#else
+				if (has_nan_scalar(first, last)) return false;
+				e = extrema_scalar(first + 1, last, extrema<T>{*first, *first});
+				return true;
+#endif // STL2_SIMD_X86
+			} else {
+#if STL2_SIMD_X86
+				if (has_avx2()) {
+					e = extrema_int_avx2(first, last);
+					return true;
+				}
+				if (has_sse42()) {
+					e = extrema_int_sse42(first, last);
+					return true;
+				}
+#endif // STL2_SIMD_X86
+				e = extrema_scalar(first + 1, last, extrema<T>{*first, *first});
+				return true;
+			}
+		}
+
+		// Returns a pointer to the first element of [first, last) that
+		// equals value, or last if there is none.
+		template<class T>
+		const T* find_value(const T* first, const T* last, const T& value) noexcept {
+			static_assert(is_orderable_lane<T>);
+			if constexpr (std::is_integral_v<T>) {
+				return find_eq(first, last, value);
+			} else {
+#if STL2_SIMD_X86
+				return has_avx2()
+					? find_fp_avx2(first, last, value)
+					: find_fp_sse2(first, last, value);
+#else
+				return find_value_scalar(first, last, value);
+#endif // STL2_SIMD_X86
+			}
+		}
+
+		// Returns a pointer to the last element of [first, last) that
+		// equals value, or last if there is none.
+		template<class T>
+		const T* rfind_value(const T* first, const T* last, const T& value) noexcept {
+			static_assert(is_orderable_lane<T>);
+#if STL2_SIMD_X86
+			return has_avx2()
+				? rfind_avx2(first, last, value)
+				: rfind_sse2(first, last, value);
+#else
+			return rfind_value_scalar(first, last, value);
+#endif // STL2_SIMD_X86
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
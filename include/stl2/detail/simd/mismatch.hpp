@@ -0,0 +1,79 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_SIMD_MISMATCH_HPP
+#define STL2_DETAIL_SIMD_MISMATCH_HPP
+
+#include <cstddef>
+#include <stl2/detail/simd/config.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// detail::simd::mismatch_bytes
+// (kernel for mismatch and lexicographical_compare over contiguous ranges
+// of integers)
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail::simd {
+		inline std::size_t mismatch_bytes_scalar(const unsigned char* a,
+			const unsigned char* b, std::size_t i, std::size_t n) noexcept
+		{
+			for (; i != n && a[i] == b[i]; ++i) {}
+			return i;
+		}
+
+#if STL2_SIMD_X86
+		inline std::size_t mismatch_bytes_sse2(const unsigned char* a,
+			const unsigned char* b, std::size_t n) noexcept
+		{
+			std::size_t i = 0;
+			for (; n - i >= 16; i += 16) {
+				const auto mask = static_cast<unsigned>(
+					_mm_movemask_epi8(_mm_cmpeq_epi8(load128(a + i), load128(b + i))));
+				if (mask != 0xffff) return i + __builtin_ctz(~mask);
+			}
+			return mismatch_bytes_scalar(a, b, i, n);
+		}
+
+		STL2_SIMD_TARGET("avx2")
+		inline std::size_t mismatch_bytes_avx2(const unsigned char* a,
+			const unsigned char* b, std::size_t n) noexcept
+		{
+			std::size_t i = 0;
+			for (; n - i >= 32; i += 32) {
+				const auto mask = static_cast<unsigned>(
+					_mm256_movemask_epi8(_mm256_cmpeq_epi8(load256(a + i), load256(b + i))));
+				if (mask != 0xffffffff) return i + __builtin_ctz(~mask);
+			}
+			return mismatch_bytes_scalar(a, b, i, n);
+		}
+#endif // STL2_SIMD_X86
+
+		// Returns the offset of the first byte at which the n bytes at a
+		// and the n bytes at b differ, or n if they are equal. Elements
+		// whose representations are compared this way differ at the
+		// element holding that byte.
+		inline std::size_t mismatch_bytes(const void* a, const void* b,
+			std::size_t n) noexcept
+		{
+			const auto p = static_cast<const unsigned char*>(a);
+			const auto q = static_cast<const unsigned char*>(b);
+#if STL2_SIMD_X86
+			return has_avx2()
+				? mismatch_bytes_avx2(p, q, n)
+				: mismatch_bytes_sse2(p, q, n);
+#else
+			return mismatch_bytes_scalar(p, q, 0, n);
+#endif // STL2_SIMD_X86
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
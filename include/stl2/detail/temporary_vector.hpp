@@ -12,7 +12,11 @@
 #ifndef STL2_DETAIL_TEMPORARY_VECTOR_HPP
 #define STL2_DETAIL_TEMPORARY_VECTOR_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
+#include <new>
 #include <stl2/type_traits.hpp>
 #include <stl2/utility.hpp>
 #include <stl2/detail/construct_destruct.hpp>
@@ -20,12 +24,119 @@
 #include <stl2/detail/algorithm/for_each.hpp>
 #include <stl2/detail/concepts/object.hpp>
 
+///////////////////////////////////////////////////////////////////////////
+// scratch_scope [Extension]
+//
+// While a scratch_scope is alive, the temporary storage that algorithms
+// like stable_sort, inplace_merge, stable_partition and reverse allocate
+// on the constructing thread comes from the given memory_resource rather
+// than std::get_temporary_buffer, and is tallied. Scopes nest; the
+// innermost applies. A request the resource cannot satisfy leaves the
+// algorithm to proceed without the storage, by its in-place fallback,
+// so a monotonic_buffer_resource over a fixed arena with
+// null_memory_resource upstream never touches the heap.
+//
+// The tasks of parallel algorithms that run on other threads allocate
+// as usual, since memory resources are not in general thread-safe.
+//
 STL2_OPEN_NAMESPACE {
 	namespace detail {
+		template<class T>
+		class temporary_buffer;
+		struct temporary_buffer_deleter;
+	}
+
+	namespace ext {
+		class scratch_scope {
+		public:
+			explicit scratch_scope(std::pmr::memory_resource& resource) noexcept
+			: resource_{&resource}, outer_{current_}
+			{
+				current_ = this;
+			}
+
+			~scratch_scope() {
+				current_ = outer_;
+			}
+
+			scratch_scope(const scratch_scope&) = delete;
+			scratch_scope& operator=(const scratch_scope&) = delete;
+
+			std::pmr::memory_resource& resource() const noexcept {
+				return *resource_;
+			}
+
+			// The total number of bytes allocated.
+			std::size_t bytes_allocated() const noexcept {
+				return allocated_;
+			}
+
+			// The most bytes held at any one time.
+			std::size_t peak_bytes() const noexcept {
+				return peak_;
+			}
+
+			// The number of requests the resource could not satisfy.
+			std::size_t failures() const noexcept {
+				return failures_;
+			}
+
+			// The innermost scope of the calling thread, if any.
+			static scratch_scope* current() noexcept {
+				return current_;
+			}
+
+		private:
+			template<class>
+			friend class detail::temporary_buffer;
+			friend struct detail::temporary_buffer_deleter;
+
+			std::pmr::memory_resource* resource_;
+			scratch_scope* outer_;
+			std::size_t in_use_ = 0;
+			std::size_t allocated_ = 0;
+			std::size_t peak_ = 0;
+			std::size_t failures_ = 0;
+
+			static inline thread_local scratch_scope* current_ = nullptr;
+
+			// Returns nullptr on failure.
+			void* allocate(std::size_t bytes, std::size_t alignment) noexcept {
+				void* ptr;
+				try {
+					ptr = resource_->allocate(bytes, alignment);
+				} catch (const std::bad_alloc&) {
+					++failures_;
+					return nullptr;
+				}
+				in_use_ += bytes;
+				allocated_ += bytes;
+				if (in_use_ > peak_) peak_ = in_use_;
+				return ptr;
+			}
+
+			void deallocate(void* ptr, std::size_t bytes, std::size_t alignment) noexcept {
+				resource_->deallocate(ptr, bytes, alignment);
+				in_use_ -= bytes;
+			}
+		};
+	}
+
+	namespace detail {
+		// Returns storage to the scratch_scope it came from, if any, else
+		// to std::return_temporary_buffer.
 		struct temporary_buffer_deleter {
+			ext::scratch_scope* scope = nullptr;
+			std::size_t bytes = 0;
+			std::size_t alignment = 0;
+
 			template<class T>
 			void operator()(T* ptr) const {
-				std::return_temporary_buffer(ptr);
+				if (scope) {
+					scope->deallocate(ptr, bytes, alignment);
+				} else {
+					std::return_temporary_buffer(ptr);
+				}
 			}
 		};
 
@@ -40,7 +151,20 @@ STL2_OPEN_NAMESPACE {
 		public:
 			temporary_buffer() = default;
 			temporary_buffer(std::ptrdiff_t n)
-			: temporary_buffer(std::get_temporary_buffer<T>(n)) {}
+			{
+				if (auto scope = ext::scratch_scope::current()) {
+					if (n <= 0 || static_cast<std::size_t>(n) > PTRDIFF_MAX / sizeof(T)) {
+						return;
+					}
+					const auto bytes = static_cast<std::size_t>(n) * sizeof(T);
+					if (void* ptr = scope->allocate(bytes, alignof(T))) {
+						alloc_ = {static_cast<T*>(ptr), {scope, bytes, alignof(T)}};
+						size_ = n;
+					}
+				} else {
+					*this = temporary_buffer{std::get_temporary_buffer<T>(n)};
+				}
+			}
 
 			T* data() const {
 				return alloc_.get();
@@ -77,9 +201,23 @@ STL2_OPEN_NAMESPACE {
 		public:
 			temporary_buffer() = default;
 			temporary_buffer(std::ptrdiff_t n)
-			: temporary_buffer(std::get_temporary_buffer<unsigned char>(
-				n * sizeof(T) + alignof(T) - 1))
-			{}
+			{
+				if (auto scope = ext::scratch_scope::current()) {
+					// memory_resource honors the alignment itself.
+					if (n <= 0 || static_cast<std::size_t>(n) > PTRDIFF_MAX / sizeof(T)) {
+						return;
+					}
+					const auto bytes = static_cast<std::size_t>(n) * sizeof(T);
+					if (void* ptr = scope->allocate(bytes, alignof(T))) {
+						alloc_ = {static_cast<unsigned char*>(ptr), {scope, bytes, alignof(T)}};
+						aligned_ = static_cast<T*>(ptr);
+						size_ = n;
+					}
+				} else {
+					*this = temporary_buffer{std::get_temporary_buffer<unsigned char>(
+						n * sizeof(T) + alignof(T) - 1)};
+				}
+			}
 
 			T* data() const {
 				return aligned_;
@@ -0,0 +1,244 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_THREAD_POOL_HPP
+#define STL2_DETAIL_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <stl2/detail/fwd.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// detail::thread_pool and detail::task_group
+// (fork-join scheduling for the parallel algorithms)
+//
+// Each worker owns a deque of tasks: it pushes and pops its own tasks at
+// the back, and steals from the front of the others' when it runs out.
+// Threads that are not workers submit to a shared queue. A thread
+// waiting on a task_group runs queued tasks until the group completes,
+// so nested fork-join never blocks a worker.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		class thread_pool {
+		public:
+			using task = std::function<void()>;
+
+			// The process-wide pool, with a worker for each hardware
+			// thread but one: the thread that waits does work too.
+			static thread_pool& instance() {
+				static thread_pool pool{std::thread::hardware_concurrency()};
+				return pool;
+			}
+
+			explicit thread_pool(unsigned concurrency) {
+				const unsigned workers = concurrency > 1 ? concurrency - 1 : 0;
+				for (unsigned i = 0; i <= workers; ++i) {
+					queues_.push_back(std::make_unique<queue>());
+				}
+				threads_.reserve(workers);
+				for (unsigned i = 0; i < workers; ++i) {
+					threads_.emplace_back([this, i] { work(i); });
+				}
+			}
+
+			~thread_pool() {
+				{
+					std::lock_guard<std::mutex> lock{sleep_mutex_};
+					stop_ = true;
+				}
+				sleep_cv_.notify_all();
+				for (auto& t : threads_) {
+					t.join();
+				}
+			}
+
+			thread_pool(const thread_pool&) = delete;
+			thread_pool& operator=(const thread_pool&) = delete;
+
+			// The number of threads that can run tasks at once.
+			std::size_t concurrency() const noexcept {
+				return threads_.size() + 1;
+			}
+
+			void submit(task t) {
+				auto& q = *queues_[own_queue()];
+				{
+					std::lock_guard<std::mutex> lock{q.mutex};
+					q.tasks.push_back(std::move(t));
+				}
+				{
+					std::lock_guard<std::mutex> lock{sleep_mutex_};
+					++queued_;
+				}
+				sleep_cv_.notify_one();
+			}
+
+			// Runs one queued task, preferring the calling thread's own.
+			// Returns false if there was none to run.
+			bool run_one() {
+				const std::size_t self = own_queue();
+				task t;
+				if (pop_back(*queues_[self], t)) {
+					run(t);
+					return true;
+				}
+				const std::size_t n = queues_.size();
+				for (std::size_t i = 1; i < n; ++i) {
+					if (pop_front(*queues_[(self + i) % n], t)) {
+						run(t);
+						return true;
+					}
+				}
+				return false;
+			}
+
+		private:
+			struct queue {
+				std::mutex mutex;
+				std::deque<task> tasks;
+			};
+
+			std::vector<std::unique_ptr<queue>> queues_;
+			std::vector<std::thread> threads_;
+			std::mutex sleep_mutex_;
+			std::condition_variable sleep_cv_;
+			std::size_t queued_ = 0;
+			bool stop_ = false;
+
+			static inline thread_local const thread_pool* current_ = nullptr;
+			static inline thread_local std::size_t current_index_ = 0;
+
+			// Workers own queues [0, threads_.size()); everyone else shares
+			// the last.
+			std::size_t own_queue() const noexcept {
+				return current_ == this ? current_index_ : queues_.size() - 1;
+			}
+
+			bool pop_back(queue& q, task& t) {
+				std::lock_guard<std::mutex> lock{q.mutex};
+				if (q.tasks.empty()) return false;
+				t = std::move(q.tasks.back());
+				q.tasks.pop_back();
+				return true;
+			}
+
+			bool pop_front(queue& q, task& t) {
+				std::lock_guard<std::mutex> lock{q.mutex};
+				if (q.tasks.empty()) return false;
+				t = std::move(q.tasks.front());
+				q.tasks.pop_front();
+				return true;
+			}
+
+			void run(task& t) {
+				{
+					std::lock_guard<std::mutex> lock{sleep_mutex_};
+					--queued_;
+				}
+				t();
+			}
+
+			void work(std::size_t index) {
+				current_ = this;
+				current_index_ = index;
+				while (true) {
+					if (run_one()) continue;
+					std::unique_lock<std::mutex> lock{sleep_mutex_};
+					sleep_cv_.wait(lock, [this] { return stop_ || queued_ > 0; });
+					if (stop_) return;
+				}
+			}
+		};
+
+		// A set of tasks that can be waited on together. The first
+		// exception thrown by a task is rethrown by wait.
+		class task_group {
+		public:
+			explicit task_group(thread_pool& pool = thread_pool::instance()) noexcept
+			: pool_(pool) {}
+
+			~task_group() {
+				join();
+			}
+
+			task_group(const task_group&) = delete;
+			task_group& operator=(const task_group&) = delete;
+
+			template<class F>
+			void run(F f) {
+				outstanding_.fetch_add(1, std::memory_order_relaxed);
+				try {
+					pool_.submit([this, f = std::move(f)]() mutable {
+						if (!cancelled()) {
+							try {
+								f();
+							} catch (...) {
+								std::lock_guard<std::mutex> lock{error_mutex_};
+								if (!error_) error_ = std::current_exception();
+								cancel();
+							}
+						}
+						outstanding_.fetch_sub(1, std::memory_order_acq_rel);
+					});
+				} catch (...) {
+					// The task was not queued, so join must not wait for it.
+					outstanding_.fetch_sub(1, std::memory_order_relaxed);
+					throw;
+				}
+			}
+
+			void wait() {
+				join();
+				if (error_) {
+					std::rethrow_exception(std::exchange(error_, nullptr));
+				}
+			}
+
+			// Tasks of a cancelled group that have not started are skipped.
+			void cancel() noexcept {
+				cancelled_.store(true, std::memory_order_relaxed);
+			}
+
+			bool cancelled() const noexcept {
+				return cancelled_.load(std::memory_order_relaxed);
+			}
+
+			thread_pool& pool() const noexcept {
+				return pool_;
+			}
+
+		private:
+			thread_pool& pool_;
+			std::atomic<std::size_t> outstanding_{0};
+			std::atomic<bool> cancelled_{false};
+			std::mutex error_mutex_;
+			std::exception_ptr error_;
+
+			void join() noexcept {
+				while (outstanding_.load(std::memory_order_acquire) != 0) {
+					if (!pool_.run_one()) std::this_thread::yield();
+				}
+			}
+		};
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
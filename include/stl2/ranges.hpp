@@ -25,6 +25,7 @@
 #include <stl2/view/drop.hpp>
 #include <stl2/view/drop_while.hpp>
 #include <stl2/view/empty.hpp>
+#include <stl2/view/eytzinger.hpp>
 #include <stl2/view/filter.hpp>
 #include <stl2/view/generate.hpp>
 #include <stl2/view/indirect.hpp>
@@ -0,0 +1,180 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_VIEW_EYTZINGER_HPP
+#define STL2_VIEW_EYTZINGER_HPP
+
+#include <memory>
+#include <utility>
+#include <stl2/functional.hpp>
+#include <stl2/detail/ebo_box.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/results.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/range/access.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/range/primitives.hpp>
+#include <stl2/detail/simd/config.hpp>
+#include <stl2/view/all.hpp>
+#include <stl2/view/view_interface.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// eytzinger_copy and eytzinger_view [Extension]
+//
+// The Eytzinger layout stores a sorted sequence as an implicit binary
+// search tree in breadth-first order: the root first, then the roots of
+// its two subtrees, and so on, with the children of the node at 1-based
+// position k at 2k and 2k + 1. A search then visits positions that are
+// packed together at the top of the tree, and the nodes a few levels
+// below the current one are contiguous and can be prefetched, which makes
+// repeated lookups in a large static table much friendlier to the cache
+// than binary search over the sorted order.
+//
+// eytzinger_copy writes a sorted range into Eytzinger order;
+// eytzinger_view wraps such a range and provides the searches.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		template<class I, class O>
+		using eytzinger_copy_result = __in_out_result<I, O>;
+
+		struct __eytzinger_copy_fn : private __niebloid {
+			template<ForwardIterator I, Sentinel<I> S, RandomAccessIterator O>
+			requires IndirectlyCopyable<I, O>
+			constexpr eytzinger_copy_result<I, O>
+			operator()(I first, S last, O result) const {
+				auto n = iter_difference_t<O>(distance(first, std::move(last)));
+				return in_order(std::move(first), n, std::move(result));
+			}
+
+			template<ForwardRange R, RandomAccessIterator O>
+			requires IndirectlyCopyable<iterator_t<R>, O>
+			constexpr eytzinger_copy_result<safe_iterator_t<R>, O>
+			operator()(R&& r, O result) const {
+				auto n = iter_difference_t<O>(distance(r));
+				return in_order(begin(r), n, std::move(result));
+			}
+		private:
+			// Visits the n nodes of the tree in order, which is the order
+			// of the input.
+			template<class I, class O>
+			static constexpr eytzinger_copy_result<I, O>
+			in_order(I first, iter_difference_t<O> n, O result) {
+				using D = iter_difference_t<O>;
+				D k = 1;
+				while (2 * k <= n) k *= 2;
+				for (D i = 0; i < n; ++i, ++first) {
+					result[k - 1] = *first;
+					if (2 * k + 1 <= n) {
+						// Leftmost node of the right subtree.
+						k = 2 * k + 1;
+						while (2 * k <= n) k *= 2;
+					} else {
+						// Up past every node whose right subtree we just left.
+						while (k & 1) k /= 2;
+						k /= 2;
+					}
+				}
+				return {std::move(first), result + n};
+			}
+		};
+
+		inline constexpr __eytzinger_copy_fn eytzinger_copy {};
+
+		template<View V>
+		requires RandomAccessRange<const V> && SizedRange<const V>
+		class STL2_EMPTY_BASES eytzinger_view
+		: public view_interface<eytzinger_view<V>>
+		, private detail::ebo_box<V, eytzinger_view<V>>
+		{
+			using base_t = detail::ebo_box<V, eytzinger_view<V>>;
+			using base_t::get;
+			using I = iterator_t<const V>;
+			using D = iter_difference_t<I>;
+		public:
+			eytzinger_view() = default;
+
+			// Pre: base holds a sorted sequence in Eytzinger order, as
+			// written by eytzinger_copy.
+			constexpr explicit eytzinger_view(V base)
+			noexcept(std::is_nothrow_move_constructible<V>::value)
+			: base_t{std::move(base)} {}
+
+			constexpr V base() const { return get(); }
+
+			constexpr I begin() const { return __stl2::begin(get()); }
+			constexpr auto end() const { return __stl2::end(get()); }
+			constexpr auto size() const { return __stl2::size(get()); }
+
+			// Returns an iterator to the least element not less than value,
+			// or end() if there is none. Pre: the sequence was sorted with
+			// respect to comp and proj.
+			template<class T, class Comp = less, class Proj = identity>
+			requires IndirectStrictWeakOrder<Comp, const T*, projected<I, Proj>>
+			constexpr I lower_bound(const T& value, Comp comp = {}, Proj proj = {}) const {
+				return search([&](auto&& e) -> bool {
+					return __stl2::invoke(comp, __stl2::invoke(proj, e), value);
+				});
+			}
+
+			// Returns an iterator to the least element greater than value,
+			// or end() if there is none.
+			template<class T, class Comp = less, class Proj = identity>
+			requires IndirectStrictWeakOrder<Comp, const T*, projected<I, Proj>>
+			constexpr I upper_bound(const T& value, Comp comp = {}, Proj proj = {}) const {
+				return search([&](auto&& e) -> bool {
+					return !__stl2::invoke(comp, value, __stl2::invoke(proj, e));
+				});
+			}
+
+			template<class T, class Comp = less, class Proj = identity>
+			requires IndirectStrictWeakOrder<Comp, const T*, projected<I, Proj>>
+			constexpr bool contains(const T& value, Comp comp = {}, Proj proj = {}) const {
+				auto i = lower_bound(value, __stl2::ref(comp), __stl2::ref(proj));
+				return i != end() && !__stl2::invoke(comp, value, __stl2::invoke(proj, *i));
+			}
+
+		private:
+			// Descends from the root, going right past elements that
+			// satisfy pred, which holds for a prefix of the sorted order.
+			// The answer is the last node at which the descent went left:
+			// strip the trailing right turns, then that left turn, from
+			// the path.
+			template<class Pred>
+			constexpr I search(Pred pred) const {
+				const auto first = begin();
+				const auto n = static_cast<D>(size());
+				D k = 1;
+				while (k <= n) {
+					if constexpr (ContiguousIterator<I>) {
+						// The first descendant four levels down; its siblings
+						// follow it on the same cache line or the next.
+						if (!detail::is_constant_evaluated() && 16 * k <= n) {
+							detail::simd::prefetch(std::addressof(*first) + (16 * k - 1));
+						}
+					}
+					k = 2 * k + (pred(first[k - 1]) ? 1 : 0);
+				}
+				while (k & 1) k /= 2;
+				k /= 2;
+				return k == 0 ? first + n : first + (k - 1);
+			}
+		};
+
+		template<Range R>
+		eytzinger_view(R&&) -> eytzinger_view<all_view<R>>;
+	} // namespace ext
+
+	template<class V>
+	inline constexpr bool enable_view<ext::eytzinger_view<V>> = true;
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -79,5 +79,19 @@ int main()
 		CHECK(!ranges::all_of(std::move(l), &S::p));
 	}
 
+#if VALIDATE_STL2
+	// Parallel, with pieces small enough to split the range
+	{
+		const ranges::ext::parallel_policy par{1000};
+		std::vector<int> v(100000, 0);
+		auto is_zero = [](int i) { return i == 0; };
+		auto is_one = [](int i) { return i == 1; };
+		CHECK(ranges::all_of(par, v, is_zero) == true);
+		CHECK(ranges::all_of(par, v, is_one) == false);
+		v[77777] = 1;
+		CHECK(ranges::all_of(par, v.begin(), v.end(), is_one) == false);
+	}
+#endif
+
 	return ::test_result();
 }
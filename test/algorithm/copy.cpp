@@ -59,6 +59,15 @@ STL2_OPEN_NAMESPACE {
 	};
 } STL2_CLOSE_NAMESPACE
 
+constexpr bool test_constexpr() {
+	int a[] = {1, 2, 3, 4};
+	int b[4] = {};
+	auto res = ranges::copy(a, b);
+	return res.in == a + 4 && res.out == b + 4 &&
+		b[0] == 1 && b[1] == 2 && b[2] == 3 && b[3] == 4;
+}
+static_assert(test_constexpr());
+
 int main() {
 	using ranges::begin;
 	using ranges::end;
@@ -112,5 +121,29 @@ int main() {
 		CHECK_EQUAL(target, {0,1,2,3,4,5,6,0});
 	}
 
+	{
+		// Overlapping ranges of trivially copyable elements
+		int buf[] = {0,1,2,3,4,5,6,7};
+		auto res5 = ranges::copy(buf + 2, buf + 8, buf);
+		CHECK(res5.in == buf + 8);
+		CHECK(res5.out == buf + 6);
+		CHECK_EQUAL(buf, {2,3,4,5,6,7,6,7});
+	}
+
+	{
+		int source[] = {1,2,3,4,5,6};
+		int target[4]{};
+		auto res6 = ranges::ext::copy(source, target);
+		CHECK(res6.in == source + 4);
+		CHECK(res6.out == target + 4);
+		CHECK_EQUAL(target, {1,2,3,4});
+
+		int target2[8]{};
+		auto res7 = ranges::ext::copy(source, target2);
+		CHECK(res7.in == source + 6);
+		CHECK(res7.out == target2 + 6);
+		CHECK_EQUAL(target2, {1,2,3,4,5,6,0,0});
+	}
+
 	return test_result();
 }
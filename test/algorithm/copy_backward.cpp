@@ -83,6 +83,15 @@ int main() {
 	CHECK(res2.out == begin(out));
 	CHECK(std::equal(a, a + size(a), out));
 
+	{
+		// Overlapping ranges of trivially copyable elements
+		int buf[] = {0,1,2,3,4,5,6,7};
+		auto res3 = ranges::copy_backward(buf, buf + 6, buf + 8);
+		CHECK(res3.in == buf + 6);
+		CHECK(res3.out == buf + 2);
+		CHECK_EQUAL(buf, {0,1,0,1,2,3,4,5});
+	}
+
 	test_repeat_view();
 	test_initializer_list();
 
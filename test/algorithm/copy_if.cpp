@@ -11,10 +11,27 @@
 //
 #include <stl2/detail/algorithm/copy_if.hpp>
 #include <algorithm>
+#include <vector>
 #include "../simple_test.hpp"
+#include "../test_utils.hpp"
 
 namespace ranges = __stl2;
 
+// Contiguous arithmetic ranges filtered by ext::compare_to predicates
+// take the stream compaction path.
+template<class T>
+void test_compare_to() {
+	for_each_compare_to_case<T>([](const std::vector<T>& v, auto comp) {
+		std::vector<T> out(v.size()), expected(v.size());
+		auto res = ranges::copy_if(v, out.begin(), ranges::ext::compare_to{comp, T(3)});
+		auto e = std::copy_if(v.begin(), v.end(), expected.begin(),
+			[&](T x) { return comp(x, T(3)); });
+		CHECK(res.in == v.end());
+		CHECK((res.out - out.begin()) == (e - expected.begin()));
+		CHECK(std::equal(out.begin(), res.out, expected.begin()));
+	});
+}
+
 int main() {
 	static const int source[] = {5,4,3,2,1,0};
 	static constexpr std::ptrdiff_t n = sizeof(source)/sizeof(source[0]);
@@ -104,5 +121,14 @@ int main() {
 		CHECK(std::count(target + n / 2, target + n, -1) == n / 2);
 	}
 
+	test_compare_to<signed char>();
+	test_compare_to<short>();
+	test_compare_to<int>();
+	test_compare_to<unsigned>();
+	test_compare_to<long long>();
+	test_compare_to<unsigned long long>();
+	test_compare_to<float>();
+	test_compare_to<double>();
+
 	return test_result();
 }
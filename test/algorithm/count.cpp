@@ -18,6 +18,21 @@ struct S
 	int i;
 };
 
+template<class T>
+void test_contiguous()
+{
+	// Long enough to exercise the vectorized kernels and their tails.
+	T a[203];
+	for (int i = 0; i < 203; ++i) {
+		a[i] = static_cast<T>(i % 10);
+	}
+	for (int v = 0; v < 10; ++v) {
+		CHECK(__stl2::count(a, static_cast<T>(v)) == (v < 3 ? 21 : 20));
+	}
+	CHECK(__stl2::count(a, static_cast<T>(10)) == 0);
+	CHECK(__stl2::count(a + 1, a + 1, static_cast<T>(1)) == 0);
+}
+
 int main()
 {
 	using namespace __stl2;
@@ -65,5 +80,17 @@ int main()
 		CHECK(count(std::move(l), 7) == 0);
 	}
 
+	test_contiguous<char>();
+	test_contiguous<unsigned char>();
+	test_contiguous<short>();
+	test_contiguous<int>();
+	test_contiguous<long long>();
+
+	{
+		unsigned char uc[] = {0xff, 1, 0xff};
+		CHECK(count(uc, -1) == 0);
+		CHECK(count(uc, 0xff) == 2);
+	}
+
 	return ::test_result();
 }
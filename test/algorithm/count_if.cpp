@@ -10,6 +10,7 @@
 // Project home: https://github.com/ericniebler/range-v3
 
 #include <stl2/detail/algorithm/count_if.hpp>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_iterators.hpp"
 
@@ -87,5 +88,14 @@ int main()
 		CHECK(count_if(std::move(l), equals(42)) == 0);
 	}
 
+	// Parallel, with pieces small enough to split the range
+	{
+		std::vector<int> v(100000);
+		for (int i = 0; i < 100000; ++i) v[i] = i % 10;
+		CHECK(count_if(ext::parallel_policy{1000}, v, [](int i) { return i == 3; }) == 10000);
+		CHECK(count_if(ext::par, v.begin(), v.end(), [](int i) { return i < 0; }) == 0);
+		CHECK(count_if(ext::par, v.begin(), v.begin(), [](int) { return true; }) == 0);
+	}
+
 	return ::test_result();
 }
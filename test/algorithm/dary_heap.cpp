@@ -0,0 +1,112 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/dary_heap.hpp>
+#include <stl2/detail/algorithm/make_heap.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+
+namespace { std::mt19937 gen; }
+
+// Each element is no greater than its parent.
+template<std::size_t Arity, class T, class Comp = std::less<>>
+bool heap_ordered(const std::vector<T>& v, Comp comp = {}) {
+	for (std::size_t i = 1; i < v.size(); ++i) {
+		if (comp(v[(i - 1) / Arity], v[i])) return false;
+	}
+	return true;
+}
+
+template<std::size_t Arity>
+void test(int n) {
+	std::vector<int> v(n);
+	for (auto& x : v) x = static_cast<int>(gen() % 100);
+	auto expected = v;
+	std::sort(expected.begin(), expected.end());
+
+	CHECK(ranges::ext::make_dary_heap<Arity>(v) == v.end());
+	CHECK(heap_ordered<Arity>(v));
+	CHECK(ranges::ext::is_dary_heap<Arity>(v));
+	CHECK(ranges::ext::is_dary_heap_until<Arity>(v.begin(), v.end()) == v.end());
+
+	// Pop everything, then push it all back one element at a time
+	for (auto i = v.end(); i != v.begin(); --i) {
+		CHECK(ranges::ext::pop_dary_heap<Arity>(v.begin(), i) == i);
+		CHECK(ranges::ext::is_dary_heap<Arity>(v.begin(), i - 1));
+		if (i != v.end()) CHECK(*(i - 1) <= *i);
+	}
+	CHECK(v == expected);
+	for (auto i = v.begin(); i != v.end(); ++i) {
+		CHECK(ranges::ext::push_dary_heap<Arity>(v.begin(), i + 1) == i + 1);
+		CHECK(ranges::ext::is_dary_heap<Arity>(v.begin(), i + 1));
+	}
+
+	CHECK(ranges::ext::sort_dary_heap<Arity>(v) == v.end());
+	CHECK(v == expected);
+
+	// is_dary_heap_until finds the first element greater than its parent;
+	// descending order is a heap of any arity
+	if (n > 1) {
+		std::reverse(v.begin(), v.end());
+		const int k = 1 + static_cast<int>(gen() % (n - 1));
+		v[k] = v[(k - 1) / Arity] + 1;
+		CHECK(ranges::ext::is_dary_heap_until<Arity>(v) == v.begin() + k);
+		CHECK(!ranges::ext::is_dary_heap<Arity>(v));
+	}
+}
+
+int main() {
+	for (int n : {0, 1, 2, 3, 4, 5, 8, 9, 17, 100, 1000}) {
+		test<2>(n);
+		test<3>(n);
+		test<4>(n);
+		test<8>(n);
+	}
+
+	// Arity 2 is the standard layout
+	{
+		std::vector<int> v(1000);
+		for (auto& x : v) x = static_cast<int>(gen());
+		ranges::ext::make_dary_heap<2>(v);
+		CHECK(std::is_heap(v.begin(), v.end()));
+		ranges::make_heap(v);
+		CHECK(ranges::ext::is_dary_heap<2>(v));
+	}
+
+	// With a comparison and a projection
+	{
+		struct S { std::string key; };
+		std::vector<S> v(500);
+		for (auto& s : v) s.key = std::to_string(gen() % 1000);
+		ranges::ext::make_dary_heap<4>(v, ranges::greater{}, &S::key);
+		CHECK(ranges::ext::is_dary_heap<4>(v, ranges::greater{}, &S::key));
+		ranges::ext::sort_dary_heap<4>(v, ranges::greater{}, &S::key);
+		CHECK(std::is_sorted(v.begin(), v.end(), [](const S& a, const S& b) {
+			return a.key > b.key;
+		}));
+	}
+
+	// Rvalue range
+	{
+		std::vector<int> v{3, 1, 2};
+		static_assert(ranges::Same<decltype(ranges::ext::make_dary_heap<4>(std::move(v))),
+			ranges::dangling>);
+	}
+
+	return ::test_result();
+}
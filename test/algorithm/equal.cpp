@@ -19,6 +19,7 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/equal.hpp>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_iterators.hpp"
 
@@ -32,6 +33,27 @@ bool counting_equals(const T &a, const T &b) {
 	return a == b;
 }
 
+// Contiguous ranges of integers are compared as memory, which must give
+// the same answers as comparing elements.
+template<class T>
+void test_contiguous() {
+	for (int n = 0; n < 70; ++n) {
+		std::vector<T> a(n);
+		for (int i = 0; i < n; ++i) a[i] = static_cast<T>(7 * i - 20);
+		std::vector<T> b = a;
+		CHECK(ranges::equal(a, b));
+		for (int k = 0; k < n; ++k) {
+			b[k] = static_cast<T>(b[k] + 1);
+			CHECK(!ranges::equal(a, b));
+			CHECK(!ranges::equal(a.data(), a.data() + n, b.data(), b.data() + n));
+			b[k] = a[k];
+		}
+		if (n > 0) {
+			CHECK(!ranges::equal(a.data(), a.data() + n, b.data(), b.data() + n - 1));
+		}
+	}
+}
+
 int main() {
 	using namespace ranges;
 
@@ -70,5 +92,19 @@ int main() {
 	test_case(false, 0,     R(ia), R(ia + s), R(ia), R(ia + s - 1));
 	test_case(false, s - 1, R(ia), S(ia + s), R(ia), S(ia + s - 1));
 
+	test_contiguous<unsigned char>();
+	test_contiguous<signed char>();
+	test_contiguous<unsigned short>();
+	test_contiguous<int>();
+	test_contiguous<unsigned>();
+	test_contiguous<long long>();
+
+	{
+		static constexpr int ca[] = {0, 1, 2};
+		static constexpr int cb[] = {0, 1, 3};
+		static_assert(equal(ca, ca));
+		static_assert(!equal(ca, cb));
+	}
+
 	return ::test_result();
 }
@@ -105,5 +105,21 @@ int main() {
 		test(some_foos, some_foos + 3, 2, &foo::i);
 	}
 
+	// Batches of needles, in and out of order
+	{
+		std::vector<int> v;
+		for (int i = 0; i < 300; ++i) v.push_back(i / 4 * 2);
+		const int needles[] = {-1, 0, 1, 2, 50, 51, 148, 149, 150, 7, 3, 100, 0};
+		std::vector<ranges::subrange<std::vector<int>::iterator>> out(ranges::size(needles));
+		auto r = ranges::ext::equal_range_batch(v, needles, out.begin());
+		CHECK(r.in == ranges::end(needles));
+		CHECK(r.out == out.end());
+		for (std::size_t i = 0; i < out.size(); ++i) {
+			auto expected = ranges::equal_range(v, needles[i]);
+			CHECK(out[i].begin() == expected.begin());
+			CHECK(out[i].end() == expected.end());
+		}
+	}
+
 	return ::test_result();
 }
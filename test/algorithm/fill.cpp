@@ -19,6 +19,7 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/fill.hpp>
+#include <cstddef>
 #include <cstring>
 #include <string>
 #include <vector>
@@ -73,12 +74,33 @@ void test_int() {
 	CHECK(ia[3] == 2);
 }
 
+template<class T>
+void test_large(const T& value) {
+	// Long enough to exercise the block-store path and its tail.
+	constexpr std::ptrdiff_t n = 131;
+	T a[n + 2] = {};
+	auto i = ranges::fill(a + 1, a + 1 + n, value);
+	CHECK(i == a + 1 + n);
+	CHECK(a[0] == T{});
+	CHECK(a[n + 1] == T{});
+	for (std::ptrdiff_t k = 1; k <= n; ++k) {
+		CHECK(a[k] == value);
+	}
+}
+
 int main() {
 	test_char<forward_iterator<char*> >();
 	test_char<bidirectional_iterator<char*> >();
 	test_char<random_access_iterator<char*> >();
 	test_char<char*>();
 
+	test_large<char>('x');
+	test_large<std::byte>(std::byte{0xa5});
+	test_large<short>(-2);
+	test_large<int>(42);
+	test_large<long long>(-1LL << 40);
+	test_large<double>(3.5);
+
 	test_char<forward_iterator<char*>, sentinel<char*> >();
 	test_char<bidirectional_iterator<char*>, sentinel<char*> >();
 	test_char<random_access_iterator<char*>, sentinel<char*> >();
@@ -85,12 +85,33 @@ void test_int() {
 	CHECK(ia[3] == 2);
 }
 
+void test_large() {
+	int a[100] = {};
+	auto i = ranges::fill_n(a, 97, 7);
+	CHECK(i == a + 97);
+	for (int k = 0; k < 97; ++k) {
+		CHECK(a[k] == 7);
+	}
+	CHECK(a[97] == 0);
+
+	unsigned char b[100] = {};
+	CHECK(ranges::fill_n(b, 99, 0x1ff) == b + 99);
+	for (int k = 0; k < 99; ++k) {
+		CHECK(b[k] == 0xff);
+	}
+	CHECK(b[99] == 0);
+	CHECK(ranges::fill_n(b, -1, 0) == b);
+	CHECK(b[0] == 0xff);
+}
+
 int main() {
 	test_char<forward_iterator<char*> >();
 	test_char<bidirectional_iterator<char*> >();
 	test_char<random_access_iterator<char*> >();
 	test_char<char*>();
 
+	test_large();
+
 	test_char<forward_iterator<char*>, sentinel<char*> >();
 	test_char<bidirectional_iterator<char*>, sentinel<char*> >();
 	test_char<random_access_iterator<char*>, sentinel<char*> >();
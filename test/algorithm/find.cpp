@@ -29,6 +29,21 @@ struct S {
 	int i_;
 };
 
+template<class T>
+void test_contiguous() {
+	// Long enough to exercise the vectorized kernels and their tails.
+	T a[203];
+	for (int i = 0; i < 203; ++i) {
+		a[i] = static_cast<T>(i % 101);
+	}
+	for (int v = 0; v < 101; ++v) {
+		CHECK(ranges::find(a, static_cast<T>(v)) == a + v);
+		CHECK(ranges::find(a + v + 1, a + 203, v) == a + v + 101);
+	}
+	CHECK(ranges::find(a, static_cast<T>(101)) == a + 203);
+	CHECK(ranges::find(a, a, static_cast<T>(0)) == a);
+}
+
 int main() {
 	using namespace ranges;
 
@@ -59,5 +74,22 @@ int main() {
 	ps = find(sa, 10, &S::i_);
 	CHECK(ps == end(sa));
 
+	test_contiguous<char>();
+	test_contiguous<unsigned char>();
+	test_contiguous<short>();
+	test_contiguous<int>();
+	test_contiguous<long long>();
+
+	{
+		// Values not representable in the element type never match.
+		unsigned char uc[] = {0xff, 1, 0xff};
+		CHECK(ranges::find(uc, -1) == end(uc));
+		CHECK(ranges::find(uc, 0xff) == uc);
+		CHECK(ranges::find(uc, 0x101) == end(uc));
+		short sh[] = {1, -1, 1};
+		CHECK(ranges::find(sh, -1) == sh + 1);
+		CHECK(ranges::find(sh, 0xffff) == end(sh));
+	}
+
 	return ::test_result();
 }
@@ -20,6 +20,7 @@
 
 #include <stl2/detail/algorithm/find_end.hpp>
 #include <stl2/utility.hpp>
+#include <string>
 #include "../simple_test.hpp"
 #include "../test_iterators.hpp"
 
@@ -195,6 +196,21 @@ void test_proj() {
 	CHECK(find_end(er, subrange(Iter2(b), Sent2(b + 1)), equal_to(), &S::i_) == Iter1(ia));
 }
 
+void test_searchers() {
+	const std::string text = "xyz..xyz..xyzxyz...";
+	const std::string pat = "xyz";
+	auto bmh = ranges::ext::boyer_moore_horspool_searcher(pat.begin(), pat.end());
+	CHECK(ranges::find_end(text, bmh) == text.begin() + 13);
+	auto tw = ranges::ext::two_way_searcher(pat.begin(), pat.end());
+	CHECK(ranges::find_end(text.begin(), text.end(), tw) == text.begin() + 13);
+
+	const std::string absent = "zx.";
+	auto bmh2 = ranges::ext::boyer_moore_horspool_searcher(absent.begin(), absent.end());
+	CHECK(ranges::find_end(text, bmh2) == text.end());
+	auto bmh3 = ranges::ext::boyer_moore_horspool_searcher(pat.begin(), pat.begin());
+	CHECK(ranges::find_end(text, bmh3) == text.end());
+}
+
 int main() {
 	test<forward_iterator<const int*>, forward_iterator<const int*> >();
 	test<forward_iterator<const int*>, bidirectional_iterator<const int*> >();
@@ -256,5 +272,7 @@ int main() {
 	test_proj<random_access_iterator<const S*>, bidirectional_iterator<const int*>, sentinel<const S*>, sentinel<const int *> >();
 	test_proj<random_access_iterator<const S*>, random_access_iterator<const int*>, sentinel<const S*>, sentinel<const int *> >();
 
+	test_searchers();
+
 	return ::test_result();
 }
@@ -20,6 +20,7 @@
 
 #include <stl2/detail/algorithm/find_if.hpp>
 #include <stl2/utility.hpp>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_iterators.hpp"
 
@@ -68,5 +69,17 @@ int main()
 	ps = find_if(sa, [](int i){return i == 10;}, &S::i_);
 	CHECK(ps == end(sa));
 
+	// Parallel, with pieces small enough to split the range: the first
+	// match is found, not just any match.
+	{
+		const ext::parallel_policy par{1000};
+		std::vector<int> v(100000, 0);
+		v[40000] = v[70000] = v[99999] = 1;
+		auto is_one = [](int i) { return i == 1; };
+		CHECK(find_if(par, v, is_one) == v.begin() + 40000);
+		CHECK(find_if(par, v.begin() + 40001, v.end(), is_one) == v.begin() + 70000);
+		CHECK(find_if(par, v, [](int i) { return i == 2; }) == v.end());
+	}
+
 	return ::test_result();
 }
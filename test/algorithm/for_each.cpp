@@ -11,6 +11,7 @@
 
 #include <stl2/iterator.hpp>
 #include <stl2/detail/algorithm/for_each.hpp>
+#include <algorithm>
 #include <vector>
 #include "../simple_test.hpp"
 
@@ -65,5 +66,16 @@ int main() {
 	int matrix[3][4] = {};
 	ranges::for_each(matrix, [](int(&)[4]){});
 
+	// Parallel, with pieces small enough to split the range
+	{
+		std::vector<int> v(100000, 1);
+		auto res = ranges::for_each(ranges::ext::parallel_policy{1000}, v,
+			[](int& i) { i *= 2; });
+		CHECK(res.in == v.end());
+		CHECK(std::count(v.begin(), v.end(), 2) == 100000);
+		ranges::for_each(ranges::ext::par, v.begin(), v.end(), [](int& i) { ++i; });
+		CHECK(std::count(v.begin(), v.end(), 3) == 100000);
+	}
+
 	return ::test_result();
 }
@@ -19,7 +19,10 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/includes.hpp>
+#include <algorithm>
 #include <functional>
+#include <random>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -100,6 +103,39 @@ void test()
 	test_comp<Iter1, Iter2>();
 }
 
+// Contiguous ranges of integers take the galloping and block-compare paths;
+// a lambda comparator takes the generic one.
+template<class V>
+void test_contiguous()
+{
+	std::mt19937 gen;
+	const std::pair<int, int> sizes[] = {
+		{0, 0}, {5, 0}, {0, 5}, {7, 3}, {100, 90}, {1000, 1000}, {5000, 40}
+	};
+	for (auto [n1, n2] : sizes) {
+		for (int range : {2 * (n1 + n2) + 1, (n1 + n2) / 4 + 1}) {
+			std::vector<V> in1(n1), in2;
+			for (auto& x : in1) x = static_cast<V>(gen() % range);
+			std::sort(in1.begin(), in1.end());
+			if (range > n1 + n2) {
+				in1.erase(std::unique(in1.begin(), in1.end()), in1.end());
+			}
+			// A subsequence of in1, which is included, and the same with
+			// one element changed, which need not be.
+			for (auto x : in1) {
+				if (gen() % in1.size() < static_cast<unsigned>(n2)) in2.push_back(x);
+			}
+			CHECK(stl2::includes(in1, in2));
+			if (!in2.empty()) {
+				in2[gen() % in2.size()] += 1;
+				std::sort(in2.begin(), in2.end());
+			}
+			CHECK(stl2::includes(in1, in2) ==
+				stl2::includes(in1, in2, [](V x, V y) { return x < y; }));
+		}
+	}
+}
+
 struct S
 {
 	int i;
@@ -112,6 +148,11 @@ struct T
 
 int main()
 {
+	test_contiguous<int>();
+	test_contiguous<unsigned>();
+	test_contiguous<long long>();
+	test_contiguous<short>();
+
 	test<input_iterator<const int*>, input_iterator<const int*> >();
 	test<input_iterator<const int*>, forward_iterator<const int*> >();
 	test<input_iterator<const int*>, bidirectional_iterator<const int*> >();
@@ -22,6 +22,8 @@
 #include <cassert>
 #include <algorithm>
 #include <random>
+#include <utility>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -134,5 +136,17 @@ int main()
 	test<random_access_iterator<int*> >();
 	test<int*>();
 
+	// Equal elements of the first half precede those of the second,
+	// whichever half is buffered.
+	for (int split : {300, 700}) {
+		std::vector<std::pair<int, int>> v(1000);
+		for (int i = 0; i < 1000; ++i) {
+			v[i] = {(i < split ? i : i - split) / 10, i};
+		}
+		stl2::inplace_merge(v, v.begin() + split, stl2::less{},
+			&std::pair<int, int>::first);
+		CHECK(std::is_sorted(v.begin(), v.end()));
+	}
+
 	return ::test_result();
 }
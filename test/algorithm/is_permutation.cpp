@@ -24,6 +24,10 @@
 
 #include <stl2/detail/algorithm/is_permutation.hpp>
 #include <stl2/utility.hpp>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -331,5 +335,40 @@ int main() {
 		test(true, a, a + 4, b, b + 4);
 	}
 
+	{
+		// Long tails of hashable values are counted in a hash table.
+		std::vector<int> a(1000);
+		for (int i = 0; i < 1000; ++i) a[i] = i % 97;
+		std::vector<int> b = a;
+		std::shuffle(b.begin(), b.end(), std::mt19937{});
+		CHECK(ranges::is_permutation(a, b));
+		CHECK(ranges::is_permutation(
+			forward_iterator<const int*>(a.data()), sentinel<const int*>(a.data() + 1000),
+			forward_iterator<const int*>(b.data()), sentinel<const int*>(b.data() + 1000)));
+		// Same values, different multiplicities.
+		auto i = std::find(b.begin(), b.end(), 1);
+		*i = 2;
+		CHECK(!ranges::is_permutation(a, b));
+		*i = 1;
+		// A value missing from the first range.
+		b.back() = 1000;
+		CHECK(!ranges::is_permutation(a, b));
+	}
+
+	{
+		struct R {
+			int id;
+			std::string name;
+		};
+		std::vector<R> a, b;
+		for (int i = 0; i < 200; ++i) {
+			a.push_back({i, std::to_string(i % 50)});
+			b.push_back({-i, std::to_string((199 - i) % 50)});
+		}
+		CHECK(ranges::is_permutation(a, b, ranges::equal_to{}, &R::name, &R::name));
+		b[3].name = "x";
+		CHECK(!ranges::is_permutation(a, b, ranges::equal_to{}, &R::name, &R::name));
+	}
+
 	return ::test_result();
 }
@@ -19,6 +19,11 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/lexicographical_compare.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -160,9 +165,56 @@ void test_iter_comp() {
 	test_iter_comp1<const int*, const int*>();
 }
 
+// Contiguous ranges of integers are compared by finding their first
+// difference in memory, which must give the same answers as comparing
+// elements.
+template<class T>
+void test_contiguous() {
+	std::mt19937 gen;
+	for (int n = 0; n < 70; ++n) {
+		for (int m = n - 2; m <= n + 2; ++m) {
+			if (m < 0) continue;
+			std::vector<T> a(n), b(m);
+			// Few distinct values, with negative ones for signed T, so
+			// that the ranges share long prefixes.
+			for (auto& x : a) x = static_cast<T>(int(gen() % 3) - 1);
+			for (int i = 0; i < m; ++i) {
+				b[i] = i < n && gen() % 8 ? a[i] : static_cast<T>(int(gen() % 3) - 1);
+			}
+			CHECK(ranges::lexicographical_compare(a, b) ==
+				std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()));
+			CHECK(ranges::lexicographical_compare(b, a) ==
+				std::lexicographical_compare(b.begin(), b.end(), a.begin(), a.end()));
+			CHECK(ranges::lexicographical_compare(a, b, ranges::greater{}) ==
+				std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(),
+					std::greater<>{}));
+		}
+	}
+}
+
 int main() {
 	test_iter();
 	test_iter_comp();
 
+	test_contiguous<unsigned char>();
+	test_contiguous<signed char>();
+	test_contiguous<unsigned short>();
+	test_contiguous<int>();
+	test_contiguous<unsigned>();
+	test_contiguous<long long>();
+
+	{
+		std::byte a[] = {std::byte{1}, std::byte{0x80}};
+		std::byte b[] = {std::byte{1}, std::byte{0x7f}, std::byte{0}};
+		CHECK(!ranges::lexicographical_compare(a, b));
+		CHECK(ranges::lexicographical_compare(b, a));
+	}
+	{
+		static constexpr int ca[] = {0, 1, 2};
+		static constexpr int cb[] = {0, 1, 3};
+		static_assert(ranges::lexicographical_compare(ca, cb));
+		static_assert(!ranges::lexicographical_compare(cb, ca));
+	}
+
 	return test_result();
 }
@@ -15,6 +15,7 @@
 
 #include <stl2/detail/algorithm/lower_bound.hpp>
 #include <stl2/view/iota.hpp>
+#include <functional>
 #include <vector>
 #include <utility>
 #include "../simple_test.hpp"
@@ -66,5 +67,57 @@ int main() {
 
 	CHECK(*ranges::lower_bound(ranges::iota_view<int>{}, 42) == 42);
 
+	// Arithmetic values ordered by less or greater, which are searched
+	// without branching, at every length and position
+	{
+		std::vector<int> v;
+		for (int i = 0; i < 100; ++i) v.push_back(i / 3);
+		std::vector<int> r(v.rbegin(), v.rend());
+		for (std::ptrdiff_t n = 0; n <= 100; ++n) {
+			for (int x = -1; x <= 34; ++x) {
+				auto expected = [&](auto pred) {
+					std::ptrdiff_t i = 0;
+					while (i < n && pred(v[i])) ++i;
+					return i;
+				};
+				CHECK((ranges::lower_bound(v.begin(), v.begin() + n, x) - v.begin()) ==
+					expected([&](int e) { return e < x; }));
+				CHECK((ranges::lower_bound(v.begin(), v.begin() + n, x + 0.5) - v.begin()) ==
+					expected([&](int e) { return e < x + 0.5; }));
+				CHECK((ranges::lower_bound(r.begin(), r.begin() + n, x, ranges::greater{}) - r.begin()) ==
+					[&] {
+						std::ptrdiff_t i = 0;
+						while (i < n && r[i] > x) ++i;
+						return i;
+					}());
+			}
+		}
+	}
+
+	// Batches of needles: sorted, which are matched in one sweep; out of
+	// order, which are searched in interleaved groups; and records
+	// searched by key, which take neither shortcut
+	{
+		std::vector<int> v;
+		for (int i = 0; i < 1000; ++i) v.push_back(i / 3);
+		std::vector<int> needles;
+		for (int x = -5; x < 340; x += 2) needles.push_back(x);
+		for (int i = 0; i < 100; ++i) needles.push_back((i * 37) % 345 - 3);
+		std::vector<std::vector<int>::iterator> out(needles.size());
+		auto r = ranges::ext::lower_bound_batch(v, needles, out.begin());
+		CHECK(r.in == needles.end());
+		CHECK(r.out == out.end());
+		for (std::size_t i = 0; i < needles.size(); ++i) {
+			CHECK(out[i] == ranges::lower_bound(v, needles[i], std::less<long>{}));
+		}
+
+		std::pair<int, int>* pout[3];
+		const int keys[] = {3, 0, 1};
+		ranges::ext::lower_bound_batch(a, keys, pout, less(), &std::pair<int, int>::first);
+		CHECK(pout[0] == &a[4]);
+		CHECK(pout[1] == &a[0]);
+		CHECK(pout[2] == &a[2]);
+	}
+
 	return test_result();
 }
@@ -23,6 +23,8 @@
 #include <numeric>
 #include <random>
 #include <algorithm>
+#include <limits>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -146,6 +148,23 @@ struct S
 	int i;
 };
 
+// Contiguous ranges of arithmetic types take a vectorized path, which
+// must find the same element as the sequential algorithm: the first
+// greatest.
+template<class T>
+void test_ties()
+{
+	// Few distinct values, so that most extrema are tied.
+	for (int n = 1; n < 100; ++n) {
+		std::vector<T> v(n);
+		for (auto& x : v) x = static_cast<T>(gen() % 5);
+		CHECK(stl2::max_element(v) ==
+			std::max_element(v.begin(), v.end()));
+		CHECK(stl2::max_element(v, stl2::greater{}) ==
+			std::max_element(v.begin(), v.end(), std::greater<>{}));
+	}
+}
+
 int main()
 {
 	test_iter<forward_iterator<const int*> >();
@@ -169,5 +188,31 @@ int main()
 	S const *ps = stl2::max_element(s, std::less<int>{}, &S::i);
 	CHECK(ps->i == 40);
 
+	{
+		// The first of equal greatest elements.
+		int a[] = {1, 3, 2, 3, 0};
+		CHECK(stl2::max_element(a) == a + 1);
+		forward_iterator<const int*> i = stl2::max_element(
+			forward_iterator<const int*>(a), forward_iterator<const int*>(a + 5));
+		CHECK(base(i) == a + 1);
+	}
+
+	test_ties<signed char>();
+	test_ties<unsigned char>();
+	test_ties<short>();
+	test_ties<unsigned short>();
+	test_ties<int>();
+	test_ties<unsigned>();
+	test_ties<long long>();
+	test_ties<unsigned long long>();
+	test_ties<float>();
+	test_ties<double>();
+
+	{
+		const double nan = std::numeric_limits<double>::quiet_NaN();
+		double e[] = {4.0, nan, 1.0, 5.0, nan, 5.0};
+		CHECK(stl2::max_element(e) == e + 3);
+	}
+
 	return test_result();
 }
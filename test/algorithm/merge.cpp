@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <memory>
 #include <utility>
+#include <vector>
 #include "../simple_test.hpp"
 
 namespace ranges = __stl2;
@@ -82,5 +83,27 @@ int main() {
 		CHECK(std::is_sorted(ic.get(), ic.get() + 2 * N));
 	}
 
+	// Long runs from each input, which the merge gallops through; equal
+	// elements of the first input precede those of the second.
+	{
+		std::vector<std::pair<int, int>> a, b;
+		for (int blk = 0; blk < 40; ++blk) {
+			auto& v = blk % 3 == 0 ? b : a;
+			for (int i = 0; i < 100; ++i) {
+				v.emplace_back(blk * 50 + i / 4, int(v.size()));
+			}
+		}
+		std::vector<std::pair<int, int>> expected(a.size() + b.size());
+		std::vector<std::pair<int, int>> actual(a.size() + b.size());
+		auto first = [](const std::pair<int, int>& p) { return p.first; };
+		std::merge(a.begin(), a.end(), b.begin(), b.end(), expected.begin(),
+			[](const auto& x, const auto& y) { return x.first < y.first; });
+		auto r = ranges::merge(a, b, actual.begin(), ranges::less{}, first, first);
+		CHECK(r.in1 == a.end());
+		CHECK(r.in2 == b.end());
+		CHECK(r.out == actual.end());
+		CHECK(actual == expected);
+	}
+
 	return ::test_result();
 }
@@ -23,6 +23,8 @@
 #include <random>
 #include <numeric>
 #include <algorithm>
+#include <limits>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -146,6 +148,22 @@ struct S
 	int i;
 };
 
+// Contiguous ranges of arithmetic types take a vectorized path, which
+// must find the same element as the sequential algorithm: the first least.
+template<class T>
+void test_ties()
+{
+	// Few distinct values, so that most extrema are tied.
+	for (int n = 1; n < 100; ++n) {
+		std::vector<T> v(n);
+		for (auto& x : v) x = static_cast<T>(gen() % 5);
+		CHECK(stl2::min_element(v) ==
+			std::min_element(v.begin(), v.end()));
+		CHECK(stl2::min_element(v, stl2::greater{}) ==
+			std::min_element(v.begin(), v.end(), std::greater<>{}));
+	}
+}
+
 int main()
 {
 	test_iter<forward_iterator<const int*> >();
@@ -169,5 +187,26 @@ int main()
 	S const *ps = stl2::min_element(s, std::less<int>{}, &S::i);
 	CHECK(ps->i == -4);
 
+	test_ties<signed char>();
+	test_ties<unsigned char>();
+	test_ties<short>();
+	test_ties<unsigned short>();
+	test_ties<int>();
+	test_ties<unsigned>();
+	test_ties<long long>();
+	test_ties<unsigned long long>();
+	test_ties<float>();
+	test_ties<double>();
+
+	{
+		// -0.0 and +0.0 are equal: the first of them is the least.
+		double d[] = {1.0, 0.0, 2.0, -0.0, 3.0};
+		CHECK(stl2::min_element(d) == d + 1);
+		// NaNs are skipped, as the sequential algorithm skips them.
+		const double nan = std::numeric_limits<double>::quiet_NaN();
+		double e[] = {4.0, nan, 1.0, nan, 1.0, 2.0};
+		CHECK(stl2::min_element(e) == e + 2);
+	}
+
 	return test_result();
 }
@@ -23,6 +23,7 @@
 #include <numeric>
 #include <random>
 #include <algorithm>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -171,6 +172,26 @@ struct S {
 	int i;
 };
 
+// Contiguous ranges of arithmetic types take a vectorized path, which
+// must find the same elements as the sequential algorithm: the first
+// least and the last greatest.
+template<class T>
+void test_ties() {
+	// Few distinct values, so that most extrema are tied.
+	for (int n = 1; n < 100; ++n) {
+		std::vector<T> v(n);
+		for (auto& x : v) x = static_cast<T>(gen() % 5);
+		auto r = ranges::minmax_element(v);
+		auto s = std::minmax_element(v.begin(), v.end());
+		CHECK(r.min == s.first);
+		CHECK(r.max == s.second);
+		r = ranges::minmax_element(v, ranges::greater{});
+		s = std::minmax_element(v.begin(), v.end(), std::greater<>{});
+		CHECK(r.min == s.first);
+		CHECK(r.max == s.second);
+	}
+}
+
 int main() {
 	test_iter<forward_iterator<const int*> >();
 	test_iter<bidirectional_iterator<const int*> >();
@@ -195,5 +216,16 @@ int main() {
 	CHECK(ps.min->i == -4);
 	CHECK(ps.max->i == 40);
 
+	test_ties<signed char>();
+	test_ties<unsigned char>();
+	test_ties<short>();
+	test_ties<unsigned short>();
+	test_ties<int>();
+	test_ties<unsigned>();
+	test_ties<long long>();
+	test_ties<unsigned long long>();
+	test_ties<float>();
+	test_ties<double>();
+
 	return test_result();
 }
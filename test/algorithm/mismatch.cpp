@@ -21,6 +21,7 @@
 #include <stl2/detail/algorithm/mismatch.hpp>
 #include <memory>
 #include <algorithm>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -70,6 +71,33 @@ struct S {
 	int i;
 };
 
+// Contiguous ranges of integers are compared as memory, which must find
+// the same position as comparing elements.
+template<class T>
+void test_contiguous() {
+	for (int n = 0; n < 70; ++n) {
+		std::vector<T> a(n);
+		for (int i = 0; i < n; ++i) a[i] = static_cast<T>(7 * i - 20);
+		std::vector<T> b = a;
+		{
+			auto r = ranges::mismatch(a, b);
+			CHECK(r.in1 == a.end());
+			CHECK(r.in2 == b.end());
+		}
+		for (int k = 0; k < n; ++k) {
+			b[k] = static_cast<T>(b[k] + 1);
+			auto r = ranges::mismatch(a, b);
+			CHECK((r.in1 - a.begin()) == k);
+			CHECK((r.in2 - b.begin()) == k);
+			// The shorter range bounds the search.
+			auto s = ranges::mismatch(a.data(), a.data() + n, b.data(), b.data() + k);
+			CHECK(s.in1 == a.data() + k);
+			CHECK(s.in2 == b.data() + k);
+			b[k] = a[k];
+		}
+	}
+}
+
 int main() {
 	test_range<input_iterator<const int*>>();
 	test_range<forward_iterator<const int*>>();
@@ -113,5 +141,18 @@ int main() {
 		CHECK(ps2.in2->i == 5);
 	}
 
+	test_contiguous<unsigned char>();
+	test_contiguous<signed char>();
+	test_contiguous<unsigned short>();
+	test_contiguous<int>();
+	test_contiguous<unsigned>();
+	test_contiguous<long long>();
+
+	{
+		static constexpr int ca[] = {0, 1, 2};
+		static constexpr int cb[] = {0, 1, 3};
+		static_assert(ranges::mismatch(ca, cb).in1 == ca + 2);
+	}
+
 	return test_result();
 }
@@ -22,6 +22,8 @@
 #include <cassert>
 #include <memory>
 #include <random>
+#include <string>
+#include <vector>
 #include <algorithm>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
@@ -49,6 +51,16 @@ test_one(unsigned N, unsigned M)
 	CHECK(stl2::nth_element(stl2::subrange(array.get(), array.get()+N), array.get()+M) == array.get()+N);
 	CHECK((unsigned)array[M] == M);
 	stl2::nth_element(array.get(), array.get()+N, array.get()+N); // begin, end, end
+
+	// In parallel, with pieces small enough to split these ranges
+	const stl2::ext::parallel_policy par{64};
+	std::shuffle(array.get(), array.get()+N, gen);
+	CHECK(stl2::nth_element(par, array.get(), array.get()+M, array.get()+N) == array.get()+N);
+	CHECK((unsigned)array[M] == M);
+	for (unsigned i = 0; i < M; ++i) CHECK((unsigned)array[i] < M);
+	std::shuffle(array.get(), array.get()+N, gen);
+	CHECK(stl2::nth_element(par, stl2::subrange(array.get(), array.get()+N), array.get()+M) == array.get()+N);
+	CHECK((unsigned)array[M] == M);
 }
 
 void
@@ -71,6 +83,39 @@ struct S
 	int i,j;
 };
 
+// A random access iterator whose difference type is int
+class int_iterator
+{
+	int* it_ = nullptr;
+public:
+	using iterator_category = stl2::random_access_iterator_tag;
+	using value_type = int;
+	using difference_type = int;
+	using reference = int&;
+
+	int_iterator() = default;
+	explicit int_iterator(int* it) : it_(it) {}
+
+	int& operator*() const { return *it_; }
+	int& operator[](int n) const { return it_[n]; }
+	int_iterator& operator++() { ++it_; return *this; }
+	int_iterator operator++(int) { return int_iterator(it_++); }
+	int_iterator& operator--() { --it_; return *this; }
+	int_iterator operator--(int) { return int_iterator(it_--); }
+	int_iterator& operator+=(int n) { it_ += n; return *this; }
+	int_iterator& operator-=(int n) { it_ -= n; return *this; }
+	friend int_iterator operator+(int_iterator x, int n) { return x += n; }
+	friend int_iterator operator+(int n, int_iterator x) { return x += n; }
+	friend int_iterator operator-(int_iterator x, int n) { return x -= n; }
+	friend int operator-(int_iterator x, int_iterator y) { return static_cast<int>(x.it_ - y.it_); }
+	friend bool operator==(int_iterator x, int_iterator y) { return x.it_ == y.it_; }
+	friend bool operator!=(int_iterator x, int_iterator y) { return x.it_ != y.it_; }
+	friend bool operator<(int_iterator x, int_iterator y) { return x.it_ < y.it_; }
+	friend bool operator>(int_iterator x, int_iterator y) { return x.it_ > y.it_; }
+	friend bool operator<=(int_iterator x, int_iterator y) { return x.it_ <= y.it_; }
+	friend bool operator>=(int_iterator x, int_iterator y) { return x.it_ >= y.it_; }
+};
+
 int main()
 {
 	int d = 0;
@@ -95,5 +140,90 @@ int main()
 	CHECK(ia[M].i == M);
 	CHECK(ia[M].j == M);
 
+	// Many equivalent elements, in both orders
+	{
+		std::vector<int> v(10000);
+		for (auto& i : v) i = gen() % 3;
+		auto expected = v;
+		std::sort(expected.begin(), expected.end());
+		for (int m : {0, 3333, 5000, 9999}) {
+			stl2::nth_element(v, v.begin() + m);
+			CHECK(v[m] == expected[m]);
+			CHECK(std::all_of(v.begin(), v.begin() + m, [&](int i) { return i <= v[m]; }));
+			CHECK(std::all_of(v.begin() + m, v.end(), [&](int i) { return i >= v[m]; }));
+		}
+		for (int m : {0, 3333, 5000, 9999}) {
+			stl2::nth_element(v, v.begin() + m, stl2::greater{});
+			CHECK(v[m] == expected[9999 - m]);
+			CHECK(std::all_of(v.begin(), v.begin() + m, [&](int i) { return i >= v[m]; }));
+			CHECK(std::all_of(v.begin() + m, v.end(), [&](int i) { return i <= v[m]; }));
+		}
+	}
+
+	// Linear against McIlroy's adversary, which decides comparisons as late
+	// as it can so that every pivot is as bad as possible
+	{
+		const int n = 100000;
+		for (int m : {0, n / 4, n / 2, n - 1}) {
+			std::vector<int> val(n, n), idx(n);
+			for (int i = 0; i < n; ++i) idx[i] = i;
+			int solid = 0, candidate = 0;
+			long comparisons = 0;
+			auto adversary = [&](int x, int y) {
+				++comparisons;
+				if (val[x] == n && val[y] == n) val[x == candidate ? x : y] = solid++;
+				if (val[x] == n) candidate = x;
+				else if (val[y] == n) candidate = y;
+				return val[x] < val[y];
+			};
+			stl2::nth_element(idx, idx.begin() + m, adversary);
+			CHECK(comparisons < 30L * n);
+			CHECK(std::all_of(idx.begin(), idx.begin() + m, [&](int i) { return val[i] <= val[idx[m]]; }));
+			CHECK(std::all_of(idx.begin() + m, idx.end(), [&](int i) { return val[i] >= val[idx[m]]; }));
+		}
+	}
+
+	// Long ranges with runs of equivalent elements take sampled pivots
+	{
+		std::vector<std::string> v(20000);
+		for (auto& s : v) s = std::to_string(gen() % 50);
+		auto expected = v;
+		std::sort(expected.begin(), expected.end());
+		for (int m : {0, 1000, 10000, 19999}) {
+			stl2::nth_element(v, v.begin() + m);
+			CHECK(v[m] == expected[m]);
+			CHECK(std::all_of(v.begin(), v.begin() + m, [&](const std::string& s) { return s <= v[m]; }));
+			CHECK(std::all_of(v.begin() + m, v.end(), [&](const std::string& s) { return s >= v[m]; }));
+		}
+	}
+
+	// Long ranges with a 32-bit difference type take sampled pivots too
+	{
+		static_assert(stl2::RandomAccessIterator<int_iterator>);
+		const int n = 100000;
+		std::vector<int> v(n);
+		for (int i = 0; i < n; ++i) v[i] = i;
+		for (int m : {0, 1000, 50000, n - 1}) {
+			std::shuffle(v.begin(), v.end(), gen);
+			const int_iterator first{v.data()};
+			CHECK(stl2::nth_element(first, first + m, first + n) == first + n);
+			CHECK(v[m] == m);
+		}
+	}
+
+	// Parallel, with many equivalent elements
+	{
+		std::vector<int> v(100000);
+		for (auto& i : v) i = gen() % 3;
+		auto expected = v;
+		std::sort(expected.begin(), expected.end());
+		for (int m : {0, 33333, 50000, 99999}) {
+			stl2::nth_element(stl2::ext::parallel_policy{1000}, v, v.begin() + m);
+			CHECK(v[m] == expected[m]);
+			CHECK(std::all_of(v.begin(), v.begin() + m, [&](int i) { return i <= v[m]; }));
+			CHECK(std::all_of(v.begin() + m, v.end(), [&](int i) { return i >= v[m]; }));
+		}
+	}
+
 	return test_result();
 }
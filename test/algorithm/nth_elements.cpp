@@ -0,0 +1,126 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/nth_elements.hpp>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+
+namespace { std::mt19937 gen; }
+
+// Each of the positions nths of v holds the element it would hold were v
+// sorted, and no element is on the wrong side of it.
+template<class T, class Comp = std::less<>>
+void check_positions(const std::vector<T>& v,
+	const std::vector<typename std::vector<T>::iterator>& nths,
+	const std::vector<T>& expected, Comp comp = {})
+{
+	for (auto nth : nths) {
+		if (nth == v.end()) continue;
+		const auto m = nth - v.begin();
+		CHECK(!comp(v[m], expected[m]));
+		CHECK(!comp(expected[m], v[m]));
+		CHECK(std::none_of(v.begin(), v.begin() + m, [&](const T& x) { return comp(v[m], x); }));
+		CHECK(std::none_of(v.begin() + m, v.end(), [&](const T& x) { return comp(x, v[m]); }));
+	}
+}
+
+template<class T, class Gen>
+void test_random(int n, int k, Gen g) {
+	std::vector<T> v(n);
+	for (auto& x : v) x = g();
+	auto expected = v;
+	std::sort(expected.begin(), expected.end());
+	std::vector<typename std::vector<T>::iterator> nths;
+	for (int i = 0; i < k; ++i) nths.push_back(v.begin() + gen() % (n + 1));
+	std::sort(nths.begin(), nths.end());
+	CHECK(ranges::ext::nth_elements(v, nths) == v.end());
+	check_positions(v, nths, expected);
+	std::sort(v.begin(), v.end());
+	CHECK(v == expected);
+}
+
+int main() {
+	// Empty range, no positions, and the end position
+	{
+		std::vector<int> v;
+		std::vector<std::vector<int>::iterator> nths;
+		CHECK(ranges::ext::nth_elements(v, nths) == v.end());
+		nths.push_back(v.end());
+		CHECK(ranges::ext::nth_elements(v.begin(), v.end(), nths) == v.end());
+	}
+
+	// Percentiles, as four calls to nth_element would compute them
+	{
+		std::vector<int> v(100000);
+		for (auto& x : v) x = static_cast<int>(gen() % 1000000);
+		auto expected = v;
+		std::sort(expected.begin(), expected.end());
+		const std::vector<std::vector<int>::iterator> nths = {
+			v.begin() + 50000, v.begin() + 90000, v.begin() + 99000, v.begin() + 99900
+		};
+		CHECK(ranges::ext::nth_elements(v.begin(), v.end(), nths) == v.end());
+		check_positions(v, nths, expected);
+	}
+
+	// Random positions, some repeated
+	for (int n : {1, 2, 7, 8, 100, 1000, 5000}) {
+		for (int k : {1, 2, 5, 50}) {
+			test_random<int>(n, k, [] { return static_cast<int>(gen() % 1000); });
+			test_random<int>(n, k, [] { return static_cast<int>(gen() % 3); });
+			test_random<std::string>(n, k, [] { return std::to_string(gen() % 100); });
+		}
+	}
+
+	// Every position sorts the range
+	{
+		std::vector<int> v(500);
+		for (auto& x : v) x = static_cast<int>(gen() % 100);
+		std::vector<std::vector<int>::iterator> nths;
+		for (auto i = v.begin(); i != v.end(); ++i) nths.push_back(i);
+		ranges::ext::nth_elements(v, nths);
+		CHECK(std::is_sorted(v.begin(), v.end()));
+	}
+
+	// With a comparison and a projection
+	{
+		struct S { int i; };
+		std::vector<S> v(1000);
+		for (auto& s : v) s.i = static_cast<int>(gen() % 1000);
+		std::vector<int> expected(v.size());
+		std::transform(v.begin(), v.end(), expected.begin(), [](const S& s) { return s.i; });
+		std::sort(expected.begin(), expected.end(), std::greater<>{});
+		const std::vector<std::vector<S>::iterator> nths = {v.begin() + 10, v.begin() + 500};
+		ranges::ext::nth_elements(v, nths, ranges::greater{}, &S::i);
+		CHECK(v[10].i == expected[10]);
+		CHECK(v[500].i == expected[500]);
+		CHECK(std::all_of(v.begin(), v.begin() + 10, [&](const S& s) { return s.i >= v[10].i; }));
+		CHECK(std::all_of(v.begin() + 11, v.begin() + 500, [&](const S& s) {
+			return s.i <= v[10].i && s.i >= v[500].i;
+		}));
+		CHECK(std::all_of(v.begin() + 501, v.end(), [&](const S& s) { return s.i <= v[500].i; }));
+	}
+
+	// Rvalue range
+	{
+		std::vector<int> v{3, 1, 2};
+		const std::vector<std::vector<int>::iterator> nths;
+		static_assert(ranges::Same<decltype(ranges::ext::nth_elements(std::move(v), nths)),
+			ranges::dangling>);
+	}
+
+	return ::test_result();
+}
@@ -23,8 +23,11 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/partition.hpp>
+#include <algorithm>
 #include <memory>
+#include <random>
 #include <utility>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -171,6 +174,30 @@ struct S {
 	int i;
 };
 
+void test_block() {
+	// Random access ranges of trivially copyable elements take the block
+	// partitioning path; exercise it across block boundaries.
+	std::mt19937 gen;
+	for (int n = 0; n < 300; n += 7) {
+		for (int mod : {2, 3, 1000}) {
+			std::vector<int> v(n);
+			for (auto& i : v) i = static_cast<int>(gen() % mod);
+			auto expected = v;
+			auto pred = [](int i) { return i % 3 == 0; };
+			auto r = ranges::partition(v, pred);
+			CHECK(r == std::partition_point(v.begin(), v.end(), pred));
+			CHECK(std::is_partitioned(v.begin(), v.end(), pred));
+			CHECK(std::is_permutation(v.begin(), v.end(), expected.begin()));
+		}
+	}
+
+	std::vector<S> v(1000);
+	for (auto& s : v) s.i = static_cast<int>(gen() % 100);
+	auto r = ranges::partition(v, [](int i) { return i < 50; }, &S::i);
+	CHECK(std::all_of(v.begin(), r, [](S s) { return s.i < 50; }));
+	CHECK(std::none_of(r, v.end(), [](S s) { return s.i < 50; }));
+}
+
 int main() {
 	test_iter<forward_iterator<int*> >();
 	test_iter<bidirectional_iterator<int*> >();
@@ -206,5 +233,7 @@ int main() {
 	for (S* i = r2; i < ia+sa; ++i)
 		CHECK(!is_odd()(i->i));
 
+	test_block();
+
 	return ::test_result();
 }
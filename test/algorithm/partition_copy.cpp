@@ -24,6 +24,9 @@
 
 #include <stl2/detail/algorithm/partition_copy.hpp>
 #include <stl2/iterator.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -120,6 +123,24 @@ void test_rvalue() {
 	CHECK(r2[3].i == 8);
 }
 
+void test_contiguous() {
+	// Contiguous ranges of trivially copyable elements take the block
+	// classification path; exercise it across block boundaries.
+	std::mt19937 gen;
+	for (int n = 0; n < 300; n += 7) {
+		std::vector<int> v(n);
+		for (auto& i : v) i = static_cast<int>(gen() % 1000);
+		std::vector<int> t(n), f(n), et(n), ef(n);
+		auto r = ranges::partition_copy(v, t.begin(), f.begin(), is_odd());
+		auto e = std::partition_copy(v.begin(), v.end(), et.begin(), ef.begin(), is_odd());
+		CHECK(r.in == v.end());
+		CHECK((r.out1 - t.begin()) == (e.first - et.begin()));
+		CHECK((r.out2 - f.begin()) == (e.second - ef.begin()));
+		CHECK(t == et);
+		CHECK(f == ef);
+	}
+}
+
 int main() {
 	test_iter<input_iterator<const int*> >();
 	test_iter<input_iterator<const int*>, sentinel<const int*>>();
@@ -129,6 +150,7 @@ int main() {
 
 	test_proj();
 	test_rvalue();
+	test_contiguous();
 
 	return ::test_result();
 }
@@ -0,0 +1,117 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/radix_sort.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+
+namespace { std::mt19937_64 gen; }
+
+template<class T, class Gen>
+void test_keys(int n, Gen g) {
+	std::vector<T> v(n);
+	for (auto& x : v) x = g();
+	auto expected = v;
+	std::sort(expected.begin(), expected.end());
+	CHECK(ranges::ext::radix_sort(v) == v.end());
+	CHECK(v == expected);
+}
+
+struct record {
+	std::string name;
+	std::int64_t key;
+};
+
+int main() {
+	for (int n : {0, 1, 2, 255, 256, 257, 10000}) {
+		test_keys<std::uint64_t>(n, [] { return gen(); });
+		test_keys<std::int64_t>(n, [] { return std::int64_t(gen()) >> (gen() % 64); });
+		test_keys<int>(n, [] { return int(gen() % 100) - 50; });
+		test_keys<unsigned char>(n, [] { return static_cast<unsigned char>(gen()); });
+		test_keys<signed char>(n, [] { return static_cast<signed char>(gen()); });
+		test_keys<double>(n, [] { return std::ldexp(double(std::int64_t(gen())), int(gen() % 200) - 100); });
+		test_keys<float>(n, [] { return float(gen() % 1000) - 500.5f; });
+		test_keys<std::array<unsigned char, 5>>(n, [] {
+			std::array<unsigned char, 5> a;
+			for (auto& c : a) c = static_cast<unsigned char>(gen() % 4);
+			return a;
+		});
+		test_keys<std::string>(n, [] {
+			std::string s(gen() % 12, '\0');
+			for (auto& c : s) c = static_cast<char>(gen());
+			return s;
+		});
+		// Long shared prefixes
+		test_keys<std::string>(n, [] {
+			return std::string(gen() % 50, 'x') + static_cast<char>('a' + gen() % 2);
+		});
+	}
+
+	// Signed zeros are ordered by sign
+	{
+		std::vector<double> v(300, 0.0);
+		for (std::size_t i = 0; i < v.size(); i += 2) v[i] = -0.0;
+		ranges::ext::radix_sort(v.begin(), v.end());
+		CHECK(std::signbit(v[149]));
+		CHECK(!std::signbit(v[150]));
+	}
+
+	// Projections to integer and string keys
+	{
+		std::vector<record> v(1000);
+		for (auto& r : v) {
+			r.key = std::int64_t(gen() % 2000) - 1000;
+			r.name = std::to_string(r.key);
+		}
+		ranges::ext::radix_sort(v, &record::key);
+		for (std::size_t i = 1; i < v.size(); ++i) {
+			CHECK(v[i - 1].key <= v[i].key);
+			CHECK(v[i].name == std::to_string(v[i].key));
+		}
+		ranges::ext::radix_sort(v.begin(), v.end(),
+			[](const record& r) { return r.name; });
+		for (std::size_t i = 1; i < v.size(); ++i) {
+			CHECK(v[i - 1].name <= v[i].name);
+			CHECK(v[i].name == std::to_string(v[i].key));
+		}
+	}
+
+	// Move-only elements
+	{
+		std::vector<std::unique_ptr<int>> v(1000);
+		for (std::size_t i = 0; i < v.size(); ++i) {
+			v[i].reset(new int(int(v.size() - i)));
+		}
+		ranges::ext::radix_sort(v, [](const std::unique_ptr<int>& p) { return *p; });
+		for (std::size_t i = 0; i < v.size(); ++i) {
+			CHECK(*v[i] == int(i + 1));
+		}
+	}
+
+	// Rvalue range
+	{
+		std::vector<int> v{3, 1, 2};
+		static_assert(ranges::Same<decltype(ranges::ext::radix_sort(std::move(v))),
+			ranges::dangling>);
+	}
+
+	return ::test_result();
+}
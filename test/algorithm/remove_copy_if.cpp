@@ -23,7 +23,9 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/remove_copy_if.hpp>
+#include <algorithm>
 #include <memory>
+#include <vector>
 #include <utility>
 #include <functional>
 #include "../simple_test.hpp"
@@ -77,6 +79,21 @@ struct S {
 	int i;
 };
 
+// Contiguous arithmetic ranges filtered by ext::compare_to predicates
+// take the stream compaction path.
+template<class T>
+void test_compare_to() {
+	for_each_compare_to_case<T>([](const std::vector<T>& v, auto comp) {
+		std::vector<T> out(v.size()), expected(v.size());
+		auto res = ranges::remove_copy_if(v, out.begin(), ranges::ext::compare_to{comp, T(3)});
+		auto e = std::remove_copy_if(v.begin(), v.end(), expected.begin(),
+			[&](T x) { return comp(x, T(3)); });
+		CHECK(res.in == v.end());
+		CHECK((res.out - out.begin()) == (e - expected.begin()));
+		CHECK(std::equal(out.begin(), res.out, expected.begin()));
+	});
+}
+
 int main() {
 	test<input_iterator<const int*>, output_iterator<int*>>();
 	test<input_iterator<const int*>, forward_iterator<int*>>();
@@ -165,5 +182,10 @@ int main() {
 		CHECK(ib[5].i == 4);
 	}
 
+	test_compare_to<unsigned char>();
+	test_compare_to<int>();
+	test_compare_to<long long>();
+	test_compare_to<double>();
+
 	return ::test_result();
 }
@@ -23,10 +23,12 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/remove_if.hpp>
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <utility>
 #include <functional>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -127,6 +129,20 @@ struct S
 	int i;
 };
 
+// Contiguous arithmetic ranges filtered by ext::compare_to predicates
+// take the stream compaction path.
+template<class T>
+void test_compare_to() {
+	for_each_compare_to_case<T>([](std::vector<T> v, auto comp) {
+		auto expected = v;
+		auto r = ranges::remove_if(v, ranges::ext::compare_to{comp, T(3)});
+		auto e = std::remove_if(expected.begin(), expected.end(),
+			[&](T x) { return comp(x, T(3)); });
+		CHECK((r - v.begin()) == (e - expected.begin()));
+		CHECK(std::equal(v.begin(), r, expected.begin()));
+	});
+}
+
 int main()
 {
 	test_iter<forward_iterator<int*> >();
@@ -190,5 +206,10 @@ int main()
 		CHECK(ia[5].i == 4);
 	}
 
+	test_compare_to<short>();
+	test_compare_to<int>();
+	test_compare_to<unsigned long long>();
+	test_compare_to<float>();
+
 	return ::test_result();
 }
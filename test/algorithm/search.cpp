@@ -24,6 +24,8 @@
 
 #include <stl2/detail/algorithm/search.hpp>
 #include <initializer_list>
+#include <string>
+#include <vector>
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include "../simple_test.hpp"
@@ -212,6 +214,70 @@ struct T
 	int i;
 };
 
+void test_searchers()
+{
+	// A long, highly periodic needle, and a short one.
+	std::string text(1000, 'a');
+	const std::string needle = std::string(40, 'a') + 'b';
+	text.replace(700, needle.size(), needle);
+	const std::string& ctext = text;
+
+	{
+		auto [b, e] = ranges::search(ctext, needle);
+		CHECK((b - ctext.begin()) == 700);
+		CHECK((e - b) == 41);
+	}
+	{
+		auto r = ranges::search(ctext.data(), ctext.data() + ctext.size(), "ab", "ab" + 2);
+		CHECK(r.begin() == ctext.data() + 739);
+		CHECK(r.end() == ctext.data() + 741);
+		r = ranges::search(ctext.data(), ctext.data() + ctext.size(), "bb", "bb" + 2);
+		CHECK(r.begin() == ctext.data() + ctext.size());
+		CHECK(r.end() == ctext.data() + ctext.size());
+	}
+	{
+		auto bmh = ranges::ext::boyer_moore_horspool_searcher(needle.begin(), needle.end());
+		auto [b, e] = ranges::search(ctext, bmh);
+		CHECK((b - ctext.begin()) == 700);
+		CHECK((e - b) == 41);
+	}
+	{
+		auto tw = ranges::ext::two_way_searcher(needle.begin(), needle.end());
+		auto [b, e] = ranges::search(ctext.begin(), ctext.end(), tw);
+		CHECK((b - ctext.begin()) == 700);
+		CHECK((e - b) == 41);
+	}
+	{
+		const std::string missing = "aaab";
+		auto bmh = ranges::ext::boyer_moore_horspool_searcher(missing.begin(), missing.end());
+		CHECK(ranges::search(ctext, bmh).begin() == ctext.begin() + 737);
+		const std::string absent = "ba";
+		auto tw = ranges::ext::two_way_searcher(absent.begin(), absent.end());
+		CHECK(ranges::search(ctext, tw).begin() == ctext.end());
+		CHECK(ranges::search(ctext, tw).end() == ctext.end());
+	}
+	{
+		// Hash-table shifts for wider elements
+		std::vector<int> v;
+		for (int i = 0; i < 500; ++i) v.push_back(i % 17);
+		const int pat[] = {15, 16, 0, 1, 2};
+		auto bmh = ranges::ext::boyer_moore_horspool_searcher(pat, pat + 5);
+		auto [b, e] = ranges::search(v, bmh);
+		CHECK((b - v.begin()) == 15);
+		CHECK((e - b) == 5);
+		auto tw = ranges::ext::two_way_searcher(pat, pat + 5);
+		CHECK((ranges::search(v, tw).begin() - v.begin()) == 15);
+	}
+	{
+		// Empty pattern
+		const char* none = nullptr;
+		auto bmh = ranges::ext::boyer_moore_horspool_searcher(none, none);
+		auto r = ranges::search(ctext, bmh);
+		CHECK(r.begin() == ctext.begin());
+		CHECK(r.end() == ctext.begin());
+	}
+}
+
 int main()
 {
 	test<forward_iterator<const int*>, forward_iterator<const int*> >();
@@ -262,5 +328,7 @@ int main()
 			ranges::search(ranges::subrange(ib), ie)));
 	}
 
+	test_searchers();
+
 	return ::test_result();
 }
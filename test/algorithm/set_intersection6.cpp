@@ -11,11 +11,50 @@
 //
 
 #include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
 #include "set_intersection.hpp"
 #include <stl2/detail/algorithm/lexicographical_compare.hpp>
 
+// Contiguous ranges of integers take the galloping and block-compare paths;
+// a lambda comparator takes the generic one.
+template<class V>
+void test_contiguous() {
+	std::mt19937 gen;
+	const std::pair<int, int> sizes[] = {
+		{0, 0}, {5, 0}, {0, 5}, {3, 7}, {100, 90}, {1000, 1000}, {5000, 40}, {40, 5000}
+	};
+	for (auto [n1, n2] : sizes) {
+		for (int range : {2 * (n1 + n2) + 1, (n1 + n2) / 4 + 1}) {
+			std::vector<V> in1(n1), in2(n2);
+			for (auto& x : in1) x = static_cast<V>(gen() % range);
+			for (auto& x : in2) x = static_cast<V>(gen() % range);
+			std::sort(in1.begin(), in1.end());
+			std::sort(in2.begin(), in2.end());
+			if (range > n1 + n2) {
+				in1.erase(std::unique(in1.begin(), in1.end()), in1.end());
+				in2.erase(std::unique(in2.begin(), in2.end()), in2.end());
+			}
+			std::vector<V> out(in1.size()), expected(in1.size());
+			auto result = stl2::set_intersection(in1, in2, out.begin());
+			auto e = stl2::set_intersection(in1, in2, expected.begin(),
+				[](V x, V y) { return x < y; });
+			CHECK(result.in1 == e.in1);
+			CHECK(result.in2 == e.in2);
+			CHECK((result.out - out.begin()) == (e.out - expected.begin()));
+			CHECK(std::equal(out.begin(), result.out, expected.begin()));
+		}
+	}
+}
+
 int main()
 {
+	test_contiguous<int>();
+	test_contiguous<std::uint32_t>();
+	test_contiguous<long long>();
+	test_contiguous<short>();
+
 	// Test projections
 	{
 		const auto in1 = std::array{S{1}, S{2}, S{2}, S{3}, S{3}, S{3}, S{4}, S{4}, S{4}, S{4}};
@@ -21,6 +21,7 @@
 #include <stl2/detail/algorithm/sort.hpp>
 #include <stl2/detail/algorithm/copy.hpp>
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <memory>
 #include <random>
@@ -180,6 +181,32 @@ test_larger_sorts(unsigned N)
 	test_larger_sorts(N, N);
 }
 
+// Inputs that defeat naive pivot selection: sorted, reversed, organ
+// pipe, sawtooth, few distinct values, and sorted with a few swaps.
+template<class T, class Comp>
+void test_patterns(int n, Comp comp)
+{
+	std::vector<std::vector<T>> inputs(7, std::vector<T>(n));
+	for (int i = 0; i < n; ++i) {
+		inputs[0][i] = T(i);
+		inputs[1][i] = T(n - i);
+		inputs[2][i] = T(i < n / 2 ? i : n - i);
+		inputs[3][i] = T(i % 37);
+		inputs[4][i] = T(i % 3);
+		inputs[5][i] = T(i);
+		inputs[6][i] = T(gen() % 1000);
+	}
+	for (int i = 0; i < 4 && n > 0; ++i) {
+		std::swap(inputs[5][gen() % n], inputs[5][gen() % n]);
+	}
+	for (auto& v : inputs) {
+		auto expected = v;
+		std::sort(expected.begin(), expected.end(), comp);
+		CHECK(ranges::sort(v, comp) == v.end());
+		CHECK(v == expected);
+	}
+}
+
 struct S
 {
 	int i, j;
@@ -252,6 +279,50 @@ int main()
 	test_larger_sorts(1000);
 	test_larger_sorts(1009);
 
+	for (int n : {23, 24, 25, 128, 129, 1000, 5000}) {
+		test_patterns<int>(n, std::less<>{});
+		test_patterns<int>(n, ranges::greater{});
+		test_patterns<double>(n, ranges::less{});
+		test_patterns<int>(n, [](int a, int b) { return a < b; });
+	}
+
+	// Check parallel sorts
+	{
+		const ranges::ext::parallel_policy par{1000};
+		for (int n : {0, 1, 999, 100000}) {
+			std::vector<int> v(n);
+			for (auto& i : v) i = int(gen() % 1000);
+			auto expected = v;
+			std::sort(expected.begin(), expected.end());
+			CHECK(ranges::sort(par, v) == v.end());
+			CHECK(v == expected);
+			std::sort(v.rbegin(), v.rend());
+			CHECK(ranges::sort(par, v.begin(), v.end(), [](int a, int b) { return a < b; }) == v.end());
+			CHECK(v == expected);
+		}
+		// Few distinct values: once a pivot equals the element before its
+		// range, the elements equal to it are set aside in one pass
+		for (int distinct : {1, 3}) {
+			std::vector<int> v(100000);
+			for (auto& i : v) i = int(gen() % distinct);
+			auto expected = v;
+			std::sort(expected.begin(), expected.end());
+			std::atomic<long> comparisons{0};
+			CHECK(ranges::sort(par, v, [&](int a, int b) {
+				comparisons.fetch_add(1, std::memory_order_relaxed);
+				return a < b;
+			}) == v.end());
+			CHECK(v == expected);
+			CHECK(comparisons.load() < 8L * (long)v.size());
+		}
+		std::vector<std::unique_ptr<int>> v(50000);
+		for(int i = 0; (std::size_t)i < v.size(); ++i)
+			v[i].reset(new int(v.size() - i - 1));
+		ranges::sort(ranges::ext::par, v, indirect_less());
+		for(int i = 0; (std::size_t)i < v.size(); ++i)
+			CHECK(*v[i] == i);
+	}
+
 	// Check move-only types
 	{
 		std::vector<std::unique_ptr<int> > v(1000);
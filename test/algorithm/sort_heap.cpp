@@ -23,8 +23,11 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/sort_heap.hpp>
+#include <cmath>
 #include <memory>
 #include <random>
+#include <string>
+#include <vector>
 #include <algorithm>
 #include <functional>
 #include "../simple_test.hpp"
@@ -177,6 +180,23 @@ void test_10(int N)
 	delete [] ib;
 }
 
+// Each pop sifts bottom-up, for about one comparison per level rather
+// than two
+void test_11(int N)
+{
+	std::vector<std::string> v(N);
+	for (auto& s : v) s = std::to_string(gen());
+	std::make_heap(v.begin(), v.end());
+	long comparisons = 0;
+	auto comp = [&](const std::string& x, const std::string& y) {
+		++comparisons;
+		return x < y;
+	};
+	CHECK(stl2::sort_heap(v, comp) == v.end());
+	CHECK(std::is_sorted(v.begin(), v.end()));
+	CHECK(comparisons < 1.25 * N * std::log2(N));
+}
+
 void test(int N)
 {
 	test_1(N);
@@ -199,6 +219,7 @@ int main()
 	test(1000);
 	test_9(1000);
 	test_10(1000);
+	test_11(100000);
 
 	return test_result();
 }
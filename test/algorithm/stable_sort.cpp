@@ -21,6 +21,7 @@
 #include <stl2/detail/algorithm/stable_sort.hpp>
 #include <cassert>
 #include <memory>
+#include <memory_resource>
 #include <random>
 #include <vector>
 #include <algorithm>
@@ -203,6 +204,72 @@ int main() {
 		}
 	}
 
+	// Check inputs made of sorted and reverse-sorted runs, which must also
+	// keep equivalent elements in order
+	{
+		std::vector<S> v;
+		for(int run = 0; run < 20; ++run)
+		{
+			int len = int(gen() % 3000);
+			for(int k = 0; k < len; ++k)
+			{
+				int key = run % 3 == 2 ? (len - k) / 4 : k / 4;
+				v.push_back(S{key, int(v.size())});
+			}
+		}
+		ranges::stable_sort(v, std::less<int>{}, &S::i);
+		for(std::size_t i = 1; i < v.size(); ++i)
+		{
+			CHECK(v[i - 1].i <= v[i].i);
+			if (v[i - 1].i == v[i].i) CHECK(v[i - 1].j < v[i].j);
+		}
+	}
+
+	// Check that scratch space comes from the innermost scratch_scope, and
+	// that sorting still succeeds when the scope runs out
+	{
+		std::vector<int> v(10000);
+		for(int i = 0; (std::size_t)i < v.size(); ++i)
+			v[i] = int(gen() % 5000);
+		std::pmr::monotonic_buffer_resource resource;
+		{
+			ranges::ext::scratch_scope scope{resource};
+			ranges::stable_sort(v);
+			CHECK(scope.bytes_allocated() >= v.size() / 2 * sizeof(int));
+			CHECK(scope.failures() == 0u);
+		}
+		CHECK(std::is_sorted(v.begin(), v.end()));
+
+		std::shuffle(v.begin(), v.end(), gen);
+		std::pmr::monotonic_buffer_resource empty{std::pmr::null_memory_resource()};
+		{
+			ranges::ext::scratch_scope scope{empty};
+			ranges::stable_sort(v);
+			CHECK(scope.bytes_allocated() == 0u);
+			CHECK(scope.failures() != 0u);
+		}
+		CHECK(std::is_sorted(v.begin(), v.end()));
+	}
+
+	// Check parallel sorts, which must keep equivalent elements in order
+	{
+		std::vector<S> v(100000, S{});
+		for(int i = 0; (std::size_t)i < v.size(); ++i)
+		{
+			v[i].i = int(gen() % 1000);
+			v[i].j = i;
+		}
+		ranges::stable_sort(ranges::ext::parallel_policy{1000}, v, std::less<int>{}, &S::i);
+		for(std::size_t i = 1; i < v.size(); ++i)
+		{
+			CHECK(v[i - 1].i <= v[i].i);
+			if (v[i - 1].i == v[i].i) CHECK(v[i - 1].j < v[i].j);
+		}
+		std::shuffle(v.begin(), v.end(), gen);
+		CHECK(ranges::stable_sort(ranges::ext::par, v.begin(), v.end(), std::less<int>{}, &S::i) == v.end());
+		CHECK(std::is_sorted(v.begin(), v.end(), [](const S& a, const S& b) { return a.i < b.i; }));
+	}
+
 	// Check rvalue range
 	{
 		std::vector<S> v(1000, S{});
@@ -10,6 +10,7 @@
 // Project home: https://github.com/caseycarter/cmcstl2
 //
 #include <stl2/detail/algorithm/transform.hpp>
+#include <vector>
 
 #include "../simple_test.hpp"
 
@@ -49,5 +50,27 @@ int main() {
 		}
 	}
 
+	// Parallel, with pieces small enough to split the range
+	{
+		const ranges::ext::parallel_policy par{1000};
+		std::vector<int> v(100000), w(100000), out(100000);
+		for (int i = 0; i < 100000; ++i) {
+			v[i] = i;
+			w[i] = 2 * i;
+		}
+		auto r1 = ranges::transform(par, v, out.begin(), [](int i) { return i + 1; });
+		CHECK(r1.in == v.end());
+		CHECK(r1.out == out.end());
+		CHECK(out[0] == 1);
+		CHECK(out[99999] == 100000);
+		auto r2 = ranges::transform(par, v.begin(), v.end(), w.begin(), w.end() - 1,
+			out.begin(), [](int i, int j) { return j - i; });
+		CHECK(r2.in1 == v.end() - 1);
+		CHECK(r2.in2 == w.end() - 1);
+		CHECK(r2.out == out.end() - 1);
+		CHECK(out[99998] == 99998);
+		CHECK(out[99999] == 100000);
+	}
+
 	return ::test_result();
 }
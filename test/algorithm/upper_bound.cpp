@@ -76,5 +76,32 @@ int main()
 
 	CHECK(*ranges::upper_bound(ranges::iota_view<int>{}, 42) == 43);
 
+	// Arithmetic values ordered by less or greater, which are searched
+	// without branching, at every length and position
+	{
+		std::vector<int> v;
+		for (int i = 0; i < 100; ++i) v.push_back(i / 3);
+		std::vector<int> r(v.rbegin(), v.rend());
+		for (std::ptrdiff_t n = 0; n <= 100; ++n) {
+			for (int x = -1; x <= 34; ++x) {
+				auto expected = [&](auto pred) {
+					std::ptrdiff_t i = 0;
+					while (i < n && pred(v[i])) ++i;
+					return i;
+				};
+				CHECK((ranges::upper_bound(v.begin(), v.begin() + n, x) - v.begin()) ==
+					expected([&](int e) { return e <= x; }));
+				CHECK((ranges::upper_bound(v.begin(), v.begin() + n, x + 0.5) - v.begin()) ==
+					expected([&](int e) { return e < x + 0.5; }));
+				CHECK((ranges::upper_bound(r.begin(), r.begin() + n, x, ranges::greater{}) - r.begin()) ==
+					[&] {
+						std::ptrdiff_t i = 0;
+						while (i < n && r[i] >= x) ++i;
+						return i;
+					}());
+			}
+		}
+	}
+
 	return test_result();
 }
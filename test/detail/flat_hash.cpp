@@ -0,0 +1,215 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/flat_hash.hpp>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+
+struct thrower {
+	static inline int budget = 0;
+	int value;
+
+	explicit thrower(int v) : value{v} {
+		if (--budget < 0) throw 42;
+	}
+	thrower(const thrower& that) : value{that.value} {
+		if (--budget < 0) throw 42;
+	}
+	thrower& operator=(const thrower&) = default;
+
+	friend bool operator==(const thrower& x, const thrower& y) {
+		return x.value == y.value;
+	}
+	friend bool operator!=(const thrower& x, const thrower& y) {
+		return !(x == y);
+	}
+	friend std::size_t hash_value(const thrower& t) {
+		return static_cast<std::size_t>(t.value);
+	}
+};
+
+template<class T>
+std::size_t distance(const T& t) {
+	std::size_t n = 0;
+	for (auto i = t.begin(); i != t.end(); ++i) ++n;
+	return n;
+}
+
+void test_churn() {
+	// Compare against std::unordered_map under a random mix of operations.
+	ranges::ext::flat_hash_map<int, int> m;
+	std::unordered_map<int, int> ref;
+	std::mt19937 gen{42};
+	for (int n = 0; n < 100000; ++n) {
+		const int k = static_cast<int>(gen() % 2000);
+		switch (gen() % 4) {
+		case 0:
+		case 1: {
+			auto [i, inserted] = m.try_emplace(k, n);
+			auto [j, ref_inserted] = ref.try_emplace(k, n);
+			CHECK(inserted == ref_inserted);
+			CHECK(i->second == j->second);
+			break;
+		}
+		case 2:
+			CHECK(m.erase(k) == ref.erase(k));
+			break;
+		default: {
+			auto i = m.find(k);
+			auto j = ref.find(k);
+			CHECK((i == m.end()) == (j == ref.end()));
+			if (j != ref.end()) CHECK(i->second == j->second);
+			break;
+		}
+		}
+		CHECK(m.size() == ref.size());
+	}
+	CHECK(distance(m) == ref.size());
+	for (auto& [k, v] : m) {
+		CHECK(ref.at(k) == v);
+	}
+
+	// Erase while iterating.
+	for (auto i = m.begin(); i != m.end();) {
+		if (i->first % 2) {
+			i = m.erase(i);
+		} else {
+			++i;
+		}
+	}
+	for (auto& [k, v] : ref) {
+		CHECK(m.contains(k) == (k % 2 == 0));
+	}
+}
+
+void test_map() {
+	ranges::ext::flat_hash_map<std::string, int> m{{"one", 1}, {"two", 2}};
+	CHECK(m.size() == 2u);
+	CHECK(m.at("one") == 1);
+	m["three"] = 3;
+	CHECK(m.count("three") == 1u);
+	CHECK(!m.insert_or_assign("three", 33).second);
+	CHECK(m["three"] == 33);
+	CHECK(!m.emplace("one", 11).second);
+	CHECK(m.at("one") == 1);
+	try {
+		(void)m.at("four");
+		CHECK(false);
+	} catch (std::out_of_range&) {}
+
+	auto copy = m;
+	CHECK(copy.size() == m.size());
+	for (auto& [k, v] : m) {
+		CHECK(copy.at(k) == v);
+	}
+	auto moved = std::move(copy);
+	CHECK(copy.empty());
+	CHECK(copy.begin() == copy.end());
+	CHECK(moved.size() == m.size());
+	moved.clear();
+	CHECK(moved.empty());
+	CHECK(moved.begin() == moved.end());
+}
+
+void test_set() {
+	ranges::ext::flat_hash_set<std::string> empty;
+	CHECK(empty.capacity() == 0u);
+	CHECK(empty.begin() == empty.end());
+	CHECK(empty.find("x") == empty.end());
+	CHECK(empty.erase("x") == 0u);
+
+	ranges::ext::flat_hash_set<std::string> s{"a", "b", "c", "a"};
+	CHECK(s.size() == 3u);
+	for (int i = 0; i < 1000; ++i) {
+		s.insert(std::to_string(i));
+	}
+	CHECK(s.size() == 1003u);
+	CHECK(distance(s) == s.size());
+	CHECK(s.contains("999"));
+	CHECK(!s.contains("1000"));
+
+	s.reserve(5000);
+	const auto capacity = s.capacity();
+	CHECK(capacity >= 5000u);
+	for (int i = 1000; i < 4000; ++i) {
+		s.insert(std::to_string(i));
+	}
+	CHECK(s.capacity() == capacity);
+	CHECK(s.size() == 4003u);
+}
+
+void test_tombstones() {
+	// A table of fixed size under churn reclaims deleted slots rather than
+	// growing without bound.
+	ranges::ext::flat_hash_set<int> s;
+	for (int i = 0; i < 100; ++i) {
+		s.insert(i);
+	}
+	const auto capacity = s.capacity();
+	for (int i = 100; i < 100000; ++i) {
+		s.erase(i - 100);
+		s.insert(i);
+	}
+	CHECK(s.size() == 100u);
+	CHECK(s.capacity() <= 2 * capacity + 1);
+	for (int i = 99900; i < 100000; ++i) {
+		CHECK(s.contains(i));
+	}
+}
+
+void test_exceptions() {
+	thrower::budget = 1000;
+	ranges::ext::flat_hash_set<thrower> s;
+	for (int i = 0; i < 100; ++i) {
+		s.emplace(i);
+	}
+	for (int budget = 0; budget < 300; budget += 7) {
+		thrower::budget = budget;
+		try {
+			for (int i = 100; i < 300; ++i) {
+				s.emplace(i);
+			}
+		} catch (int) {}
+		thrower::budget = 1000;
+		CHECK(distance(s) == s.size());
+		for (int i = 0; i < 100; ++i) {
+			CHECK(s.contains(thrower{i}));
+		}
+	}
+}
+
+int main() {
+	using S = ranges::ext::flat_hash_set<int>;
+	using M = ranges::ext::flat_hash_map<int, std::string>;
+	static_assert(ranges::ForwardRange<S>);
+	static_assert(ranges::SizedRange<S>);
+	static_assert(!ranges::View<S>);
+	static_assert(ranges::ForwardRange<const M>);
+	static_assert(ranges::SizedRange<M>);
+	static_assert(!ranges::View<M>);
+	static_assert(ranges::Same<ranges::iter_reference_t<ranges::iterator_t<S>>, const int&>);
+	static_assert(ranges::Same<ranges::iter_reference_t<ranges::iterator_t<M>>,
+		std::pair<const int, std::string>&>);
+
+	test_churn();
+	test_map();
+	test_set();
+	test_tombstones();
+	test_exceptions();
+
+	return ::test_result();
+}
@@ -0,0 +1,105 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/hash.hpp>
+#include <cstddef>
+#include <list>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+
+namespace ns {
+	struct customized {
+		int key;
+		int ignored;
+	};
+
+	std::size_t hash_value(const customized& c) {
+		return static_cast<std::size_t>(c.key);
+	}
+
+	struct opaque {};
+}
+
+enum class color { red, green };
+
+int main() {
+	using ranges::ext::hash;
+	using ranges::ext::hash_range;
+
+	static_assert(ranges::ext::Hashable<int>);
+	static_assert(ranges::ext::Hashable<double>);
+	static_assert(ranges::ext::Hashable<color>);
+	static_assert(ranges::ext::Hashable<const char*>);
+	static_assert(ranges::ext::Hashable<std::string>);
+	static_assert(ranges::ext::Hashable<std::vector<std::string>>);
+	static_assert(ranges::ext::Hashable<std::list<int>>);
+	static_assert(ranges::ext::Hashable<ns::customized>);
+	static_assert(!ranges::ext::Hashable<ns::opaque>);
+	static_assert(!ranges::ext::Hashable<std::vector<ns::opaque>>);
+
+	// Values that compare equal hash equal.
+	CHECK(hash(42) == hash(42));
+	CHECK(hash(0.0) == hash(-0.0));
+	CHECK(hash(color::green) == hash(color::green));
+	CHECK(hash(std::string("hello")) == hash(std::string_view("hello")));
+	CHECK(hash(std::vector<int>{1, 2, 3}) == hash_range(std::vector<int>{1, 2, 3}));
+	CHECK(hash(std::list<int>{1, 2, 3}) == hash(std::list<int>{1, 2, 3}));
+	CHECK(hash(ns::customized{1, 2}) == hash(ns::customized{1, 3}));
+	CHECK(hash(std::vector<ns::customized>{{1, 2}, {4, 5}}) ==
+		hash(std::vector<ns::customized>{{1, 3}, {4, 6}}));
+
+	{
+		// Consecutive integers and short strings spread over the low bits.
+		std::set<std::size_t> buckets;
+		for (int i = 0; i < 1024; ++i) {
+			buckets.insert(hash(i) & 1023);
+		}
+		CHECK(buckets.size() > 512u);
+
+		buckets.clear();
+		for (int i = 0; i < 1024; ++i) {
+			buckets.insert(hash(std::to_string(i)) & 1023);
+		}
+		CHECK(buckets.size() > 512u);
+	}
+
+	{
+		// Every length of contiguous input, and the seed, matter.
+		std::string s;
+		std::set<std::size_t> hashes;
+		for (int i = 0; i < 200; ++i) {
+			hashes.insert(hash(s));
+			s.push_back('x');
+		}
+		CHECK(hashes.size() == 200u);
+		CHECK(hash_range(s, 1) != hash_range(s, 2));
+		CHECK(hash_range(s.begin(), s.end()) == hash_range(s));
+	}
+
+	{
+		// The order of elements matters.
+		std::vector<std::string> a{"a", "b"}, b{"b", "a"};
+		CHECK(hash(a) != hash(b));
+		std::size_t seed1 = 0, seed2 = 0;
+		ranges::ext::hash_combine(seed1, 1);
+		ranges::ext::hash_combine(seed1, 2);
+		ranges::ext::hash_combine(seed2, 2);
+		ranges::ext::hash_combine(seed2, 1);
+		CHECK(seed1 != seed2);
+	}
+
+	return ::test_result();
+}
@@ -1,4 +1,6 @@
 #include <stl2/detail/temporary_vector.hpp>
+#include <cstdint>
+#include <memory_resource>
 #include "../simple_test.hpp"
 
 namespace ranges = __stl2;
@@ -29,9 +31,53 @@ namespace {
 	void test_alignments() {
 		(test_single_alignment<Alignments>(), ...);
 	}
+
+	void test_scratch_scope() {
+		alignas(std::max_align_t) unsigned char arena[4096];
+		std::pmr::monotonic_buffer_resource resource{arena, sizeof(arena),
+			std::pmr::null_memory_resource()};
+		auto in_arena = [&](void* p) {
+			auto a = reinterpret_cast<std::uintptr_t>(arena);
+			auto q = reinterpret_cast<std::uintptr_t>(p);
+			return a <= q && q < a + sizeof(arena);
+		};
+
+		CHECK(ranges::ext::scratch_scope::current() == nullptr);
+		{
+			ranges::ext::scratch_scope scope{resource};
+			CHECK(ranges::ext::scratch_scope::current() == &scope);
+			{
+				auto a = temporary_buffer<int>{100};
+				CHECK(a.size() == 100);
+				CHECK(in_arena(a.data()));
+				{
+					auto b = temporary_buffer<double>{50};
+					CHECK(b.size() == 50);
+					CHECK(in_arena(b.data()));
+				}
+				// More than is left: no storage, rather than the heap.
+				auto c = temporary_buffer<int>{4096};
+				CHECK(c.size() == 0);
+			}
+			CHECK(scope.bytes_allocated() == 100 * sizeof(int) + 50 * sizeof(double));
+			CHECK(scope.peak_bytes() == 100 * sizeof(int) + 50 * sizeof(double));
+			CHECK(scope.failures() == 1u);
+
+			{
+				ranges::ext::scratch_scope inner{*std::pmr::new_delete_resource()};
+				CHECK(ranges::ext::scratch_scope::current() == &inner);
+				auto d = temporary_buffer<int>{4096};
+				CHECK(d.size() == 4096);
+				CHECK(inner.bytes_allocated() == 4096 * sizeof(int));
+			}
+			CHECK(ranges::ext::scratch_scope::current() == &scope);
+		}
+		CHECK(ranges::ext::scratch_scope::current() == nullptr);
+	}
 }
 
 int main() {
 	test_alignments<1, 2, 4, 8, 16, 32, 64, 128>();
+	test_scratch_scope();
 	return ::test_result();
 }
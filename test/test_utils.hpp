@@ -11,9 +11,12 @@
 #define RANGES_TEST_UTILS_HPP
 
 #include <stl2/iterator.hpp>
+#include <stl2/detail/functional/comparisons.hpp>
 
 #include <algorithm>
 #include <initializer_list>
+#include <random>
+#include <vector>
 #include "./test_iterators.hpp"
 #include "./simple_test.hpp"
 
@@ -115,4 +118,26 @@ test_range_algo_2<Algo, RvalueOK1, RvalueOK2> make_testable_2(Algo algo)
 	return test_range_algo_2<Algo, RvalueOK1, RvalueOK2>{algo};
 }
 
+// Calls check(v, comp) with vectors v of small values of T around 3, of
+// lengths short and long enough to exercise every tail and chunk boundary
+// of the contiguous fast paths, and each comparison comp that
+// ext::compare_to recognizes.
+template<typename T, typename F>
+void for_each_compare_to_case(F check)
+{
+	std::mt19937 gen;
+	for (int n : {0, 1, 3, 7, 8, 9, 31, 32, 33, 100, 127, 128, 129, 255, 256, 257,
+		1000, 1023, 1024, 1025, 5000})
+	{
+		std::vector<T> v(n);
+		for (auto& x : v) x = static_cast<T>(static_cast<int>(gen() % 21) - 10);
+		check(v, __stl2::equal_to{});
+		check(v, __stl2::not_equal_to{});
+		check(v, __stl2::less{});
+		check(v, __stl2::greater{});
+		check(v, __stl2::less_equal{});
+		check(v, __stl2::greater_equal{});
+	}
+}
+
 #endif
@@ -0,0 +1,87 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/view/eytzinger.hpp>
+#include <stl2/view/iota.hpp>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "../simple_test.hpp"
+#include "../test_iterators.hpp"
+
+namespace ranges = __stl2;
+
+int main() {
+	using ranges::ext::eytzinger_copy;
+	using ranges::ext::eytzinger_view;
+
+	{
+		int sorted[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+		int out[10] = {};
+		auto r = eytzinger_copy(sorted, out);
+		CHECK(r.in == ranges::end(sorted));
+		CHECK(r.out == ranges::end(out));
+		CHECK_EQUAL(out, {7, 4, 9, 2, 6, 8, 10, 1, 3, 5});
+
+		auto v = eytzinger_view{out};
+		static_assert(ranges::View<decltype(v)>);
+		CHECK(v.size() == 10u);
+		CHECK(*v.lower_bound(1) == 1);
+		CHECK(*v.lower_bound(6) == 6);
+		CHECK(*v.upper_bound(6) == 7);
+		CHECK(v.lower_bound(11) == v.end());
+		CHECK(v.upper_bound(10) == v.end());
+		CHECK(v.contains(3));
+		CHECK(!v.contains(0));
+		CHECK(!v.contains(11));
+	}
+
+	// Every length and every search, with duplicates, against the
+	// searches of the sorted sequence.
+	for (int n = 0; n <= 70; ++n) {
+		std::vector<int> sorted(n);
+		for (int i = 0; i < n; ++i) sorted[i] = i / 3;
+		std::vector<int> out(n);
+		eytzinger_copy(forward_iterator<const int*>{sorted.data()},
+			forward_iterator<const int*>{sorted.data() + n}, out.begin());
+		CHECK(std::is_permutation(out.begin(), out.end(), sorted.begin()));
+
+		auto v = eytzinger_view{out};
+		for (int x = -1; x <= n / 3 + 1; ++x) {
+			auto lb = std::lower_bound(sorted.begin(), sorted.end(), x);
+			auto ub = std::upper_bound(sorted.begin(), sorted.end(), x);
+			auto elb = v.lower_bound(x);
+			auto eub = v.upper_bound(x);
+			CHECK((lb == sorted.end()) == (elb == v.end()));
+			if (lb != sorted.end() && elb != v.end()) CHECK(*elb == *lb);
+			CHECK((ub == sorted.end()) == (eub == v.end()));
+			if (ub != sorted.end() && eub != v.end()) CHECK(*eub == *ub);
+			CHECK(v.contains(x) == (lb != ub));
+		}
+	}
+
+	// Records searched by key, in descending order.
+	{
+		std::vector<std::pair<int, char>> sorted;
+		for (int i = 0; i < 26; ++i) sorted.emplace_back(100 - 2 * i, char('a' + i));
+		std::vector<std::pair<int, char>> out(sorted.size());
+		eytzinger_copy(sorted, out.begin());
+		auto v = eytzinger_view{out};
+		auto i = v.lower_bound(61, ranges::greater{}, &std::pair<int, char>::first);
+		CHECK(i != v.end());
+		CHECK(i->first == 60);
+		CHECK(i->second == 'u');
+		CHECK(v.contains(60, ranges::greater{}, &std::pair<int, char>::first));
+		CHECK(!v.contains(61, ranges::greater{}, &std::pair<int, char>::first));
+	}
+
+	return ::test_result();
+}